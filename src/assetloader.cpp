@@ -0,0 +1,50 @@
+#include "assetloader.h"
+#include "bakedassets.h"
+#include <QDir>
+#include <QFile>
+#include <cstring>
+
+namespace {
+
+/** 只读包装预解码像素（不拷贝；写入时 QImage 才会自行分离）。 */
+QImage wrap(const BakedAssets::Image &baked) {
+    return QImage(baked.pixels, baked.width, baked.height, baked.bytesPerLine, QImage::Format_ARGB32_Premultiplied);
+}
+
+const QString &overrideDir() {
+    static const QString dir = qEnvironmentVariable("DINO_ASSET_DIR");
+    return dir;
+}
+
+} // namespace
+
+QString AssetLoader::overridePath(const char *resourcePath) {
+    if (overrideDir().isEmpty()) {
+        return QString();
+    }
+    // ":/dino/DinoRun1.png" -> "<dir>/dino/DinoRun1.png"
+    const QString path = QDir(overrideDir()).filePath(QString::fromLatin1(resourcePath).mid(2));
+    return QFile::exists(path) ? path : QString();
+}
+
+QImage AssetLoader::load(const char *resourcePath) {
+    const QString file = overridePath(resourcePath);
+    if (file.isEmpty()) {
+        for (int i = 0; i < BakedAssets::imageCount; ++i) {
+            if (std::strcmp(BakedAssets::images[i].path, resourcePath) == 0) {
+                return wrap(BakedAssets::images[i]);
+            }
+        }
+    }
+    return QImage(file.isEmpty() ? QString::fromLatin1(resourcePath) : file)
+        .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+QImage AssetLoader::bakedSprite(int index, const char *resourcePath) {
+    if (index < 0 || index >= BakedAssets::spriteCount
+        || std::strcmp(BakedAssets::sprites[index].path, resourcePath) != 0
+        || !overridePath(resourcePath).isEmpty()) {
+        return QImage();
+    }
+    return wrap(BakedAssets::sprites[index]);
+}
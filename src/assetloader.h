@@ -0,0 +1,38 @@
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include <QImage>
+#include <QString>
+
+/**
+ * 贴图加载入口：按“覆盖文件 > 预解码数据 > qrc 中的 PNG”的顺序取图。
+ * 覆盖目录由环境变量 DINO_ASSET_DIR 指定，资源 ":/dino/DinoRun1.png"
+ * 对应覆盖文件 "$DINO_ASSET_DIR/dino/DinoRun1.png"，用于替换贴图（模组）。
+ * 返回的图片统一为 ARGB32_Premultiplied；预解码数据是零拷贝包装的只读内存。
+ */
+namespace AssetLoader {
+
+/**
+ * 资源的覆盖文件路径。
+ * @param resourcePath qrc 路径（":/..."）。
+ * @return 覆盖文件存在时返回其路径，否则返回空串。
+ */
+QString overridePath(const char *resourcePath);
+
+/**
+ * 加载一张未缩放的贴图。
+ * @param resourcePath qrc 路径。
+ */
+QImage load(const char *resourcePath);
+
+/**
+ * 取 SpriteCache 第 index 个条目的预解码图。来源路径不符或该资源被覆盖时返回空图，
+ * 调用方应改为自行解码缩放。
+ * @param index 条目句柄。
+ * @param resourcePath 该条目的来源资源路径。
+ */
+QImage bakedSprite(int index, const char *resourcePath);
+
+} // namespace AssetLoader
+
+#endif // ASSETLOADER_H
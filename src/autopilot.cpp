@@ -0,0 +1,70 @@
+#include "autopilot.h"
+#include "gameconfig.h"
+#include "jumptable.h"
+
+namespace {
+
+/** 向下取整的整数除法（b > 0）。 */
+int floorDiv(int a, int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/** 向上取整的整数除法（b > 0）。 */
+int ceilDiv(int a, int b) {
+    return -floorDiv(-a, b);
+}
+
+} // namespace
+
+InputState autopilot(const GameWorld &world) {
+    InputState in;
+    const QRect dinoRect = world.getDino().boundingRect();
+    const int duckTop = GameConfig::dinoGroundY + GameConfig::dinoDuckYOffset;
+    const ObstacleStore &obstacles = world.getObstacles();
+    for (int i = 0; i < obstacles.size(); ++i) {
+        if (obstacles.x(i) + obstacles.width(i) < dinoRect.left()) {
+            continue; // already passed
+        }
+        int gap = obstacles.x(i) - dinoRect.right();
+        if (obstacles.y(i) + obstacles.height(i) <= duckTop) {
+            in.duck = gap <= world.getSpeed() * 4; // high bird: stay down until it has passed
+        }
+        else {
+            in.jump = gap >= 0 && gap <= world.getSpeed() * 4;
+        }
+        break;
+    }
+    return in;
+}
+
+/**
+ * 采样点按 JumpTable 的约定计算：本步起跳时 τ = n 的离地高度为 arcHeight(n)，
+ * 障碍与恐龙碰撞区间相交的采样点为 [k0, k1]。k1 首次落进越过窗口的那一步就是最早起跳时刻。
+ * 下一步的速度按 speedAt() 预先算出，与 step() 使用的值一致。
+ */
+InputState perfectPilot(const GameWorld &world) {
+    InputState in;
+    const int speed = GameWorld::speedAt(world.getFrameCount());
+    const ObstacleStore &obstacles = world.getObstacles();
+    bool birdAhead = false; // an unpassed duckable obstacle comes before the next jump
+    for (int i = 0; i < obstacles.size(); ++i) {
+        const int k1 = ceilDiv(obstacles.x(i) + obstacles.width(i) - 1 - JumpTable::dinoLeft, speed);
+        if (k1 <= 0) {
+            continue; // already passed
+        }
+        const int k0 = floorDiv(obstacles.x(i) - JumpTable::dinoRight, speed);
+        const JumpTable::Hurdle h = JumpTable::hurdle(obstacles.y(i), obstacles.width(i), obstacles.height(i));
+        if (h.duck) {
+            in.duck = in.duck || k0 <= 2; // one extra step: the sweep lerps from the standing pose
+            birdAhead = true;
+            continue;
+        }
+        const JumpTable::Window &window = JumpTable::windows[static_cast<size_t>(h.need)];
+        in.jump = !birdAhead && !world.getDino().airborne() && k1 <= window.last;
+        break;
+    }
+    if (in.jump) {
+        in.duck = false;
+    }
+    return in;
+}
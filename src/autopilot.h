@@ -0,0 +1,23 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include "gameworld.h"
+
+/**
+ * 简单自动驾驶：最近的前方障碍进入起跳距离时跳跃，高飞的鸟则下蹲躲过。
+ * 供无头仿真、基准测试与录屏在没有玩家输入时驱动世界。
+ * @param world 当前世界状态。
+ * @return 本帧输入。
+ */
+InputState autopilot(const GameWorld &world);
+
+/**
+ * 按跳跃可达性表操作的“完美”玩家：每个必须跳过的障碍都在越过窗口允许的最早时刻起跳，
+ * 前方还有未离开的高飞鸟时不起跳，鸟即将到达时下蹲。生成逻辑满足 JumpTable 的间距条件时，
+ * 它在包围盒模型下不会死亡，dino_montecarlo 用它统计生成是否公平。
+ * @param world 当前世界状态。
+ * @return 本帧输入。
+ */
+InputState perfectPilot(const GameWorld &world);
+
+#endif // AUTOPILOT_H
@@ -0,0 +1,84 @@
+#include "backgroundwriter.h"
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+#include <QtGlobal>
+#include <algorithm>
+
+BackgroundWriter::BackgroundWriter() : thread(QThread::create([this] { run(); })) {
+    thread->start(QThread::LowPriority);
+}
+
+BackgroundWriter::~BackgroundWriter() {
+    {
+        QMutexLocker locker(&mutex);
+        stopping = true;
+        wake.wakeOne();
+    }
+    thread->wait();
+}
+
+void BackgroundWriter::write(const QString &path, const QByteArray &data) {
+    QMutexLocker locker(&mutex);
+    auto it = std::find_if(pending.begin(), pending.end(),
+                           [&path](const std::pair<QString, QByteArray> &p) { return p.first == path; });
+    if (it != pending.end()) {
+        it->second = data; // superseded before it was written
+    }
+    else {
+        pending.emplace_back(path, data);
+    }
+    wake.wakeOne();
+}
+
+void BackgroundWriter::post(std::function<void()> task) {
+    QMutexLocker locker(&mutex);
+    tasks.push_back(std::move(task));
+    wake.wakeOne();
+}
+
+void BackgroundWriter::flush() {
+    QMutexLocker locker(&mutex);
+    while (!pending.empty() || !tasks.empty() || busy) {
+        idle.wait(&mutex);
+    }
+}
+
+/**
+ * 每次取走整批待写内容与任务后释放锁再执行，期间新的提交不会被阻塞。
+ * 退出前先把已提交的内容写完、任务执行完。
+ */
+void BackgroundWriter::run() {
+    std::vector<std::pair<QString, QByteArray>> batch;
+    std::vector<std::function<void()>> jobs;
+    QMutexLocker locker(&mutex);
+    for (;;) {
+        while (pending.empty() && tasks.empty() && !stopping) {
+            wake.wait(&mutex);
+        }
+        if (pending.empty() && tasks.empty()) {
+            break; // stopping and drained
+        }
+        batch.swap(pending);
+        jobs.swap(tasks);
+        busy = true;
+        locker.unlock();
+
+        for (const std::function<void()> &job : jobs) {
+            job();
+        }
+        jobs.clear();
+
+        for (const auto &[path, data] : batch) {
+            QSaveFile file(path);
+            if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+                qWarning("Failed to write %s", qPrintable(path));
+            }
+        }
+        batch.clear();
+
+        locker.relock();
+        busy = false;
+        idle.wakeAll();
+    }
+}
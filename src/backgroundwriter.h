@@ -0,0 +1,62 @@
+#ifndef BACKGROUNDWRITER_H
+#define BACKGROUNDWRITER_H
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QWaitCondition>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class QThread;
+
+/**
+ * 后台文件写入器：调用方只把“某路径的新内容”交给它即返回，
+ * 专用线程用 QSaveFile 写入临时文件后原子重命名，进程中途崩溃也不会留下半个文件。
+ * 同一路径尚未写出的旧内容会被新内容直接替换，频繁保存时只写最后一次。
+ * 也可以提交任意任务（如追加跑局历史），在同一线程按提交顺序执行。
+ */
+class BackgroundWriter {
+public:
+    /** 构造并启动写入线程。 */
+    BackgroundWriter();
+
+    /** 写完全部待写内容后结束线程。 */
+    ~BackgroundWriter();
+
+    BackgroundWriter(const BackgroundWriter &) = delete;
+    BackgroundWriter &operator=(const BackgroundWriter &) = delete;
+
+    /**
+     * 提交一次写入（不阻塞）。
+     * @param path 目标文件路径（整体替换）。
+     * @param data 文件全部内容。
+     */
+    void write(const QString &path, const QByteArray &data);
+
+    /**
+     * 提交一个任务（不阻塞），在写入线程按提交顺序执行，用于可能触发磁盘 I/O 的操作。
+     * 任务引用的对象须比写入器活得久（析构时会先执行完全部任务）。
+     * @param task 要执行的任务。
+     */
+    void post(std::function<void()> task);
+
+    /** 阻塞直到此前提交的写入全部完成。 */
+    void flush();
+private:
+    /** 写入线程主循环。 */
+    void run();
+
+    QMutex mutex;
+    QWaitCondition wake;  // 有新任务或需要退出
+    QWaitCondition idle;  // 队列清空且当前批次写完
+    std::vector<std::pair<QString, QByteArray>> pending; // 按路径去重的待写内容
+    std::vector<std::function<void()>> tasks; // 待执行任务（按提交顺序）
+    bool busy = false;     // 写入线程正在写一个批次
+    bool stopping = false; // 析构中
+    std::unique_ptr<QThread> thread;
+};
+
+#endif // BACKGROUNDWRITER_H
@@ -0,0 +1,32 @@
+#ifndef BAKEDASSETS_H
+#define BAKEDASSETS_H
+
+#include <QtGlobal>
+
+/**
+ * 构建时由 dino_bake 生成的预解码贴图数据（见 bakedassets.cpp，位于构建目录）。
+ * 像素均为 ARGB32_Premultiplied；每个数组的起始地址 16 字节对齐，行与行紧密相接（bytesPerLine = 宽度 × 4，
+ * 行首不保证 16 字节对齐）。运行时直接用 QImage 包装只读内存，不解码也不拷贝。dino_bake 自身链接 bakedassets_none.cpp（空表）。
+ */
+namespace BakedAssets {
+
+/** 一张预解码贴图。 */
+struct Image {
+    const char *path;   // 来源资源路径（qrc）
+    int width;          // 宽度（像素）
+    int height;         // 高度（像素）
+    int bytesPerLine;   // 每行字节数
+    const uchar *pixels; // 像素数据
+};
+
+/** SpriteCache 的全部条目，按句柄顺序（已缩放到绘制尺寸）。 */
+extern const Image *const sprites;
+extern const int spriteCount;
+
+/** 渲染层直接使用的未缩放贴图（地面、云朵、UI）。 */
+extern const Image *const images;
+extern const int imageCount;
+
+} // namespace BakedAssets
+
+#endif // BAKEDASSETS_H
@@ -0,0 +1,9 @@
+#include "bakedassets.h"
+
+// dino_bake produces the real tables; it must itself load from PNG
+namespace BakedAssets {
+const Image *const sprites = nullptr;
+const int spriteCount = 0;
+const Image *const images = nullptr;
+const int imageCount = 0;
+} // namespace BakedAssets
@@ -0,0 +1,106 @@
+#include "spritecache.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QImage>
+#include <QSaveFile>
+#include <QStringList>
+#include <QTextStream>
+#include <cstdio>
+
+namespace {
+
+/**
+ * 输出一张贴图的像素数组（数组起始 16 字节对齐，ARGB32_Premultiplied 原始字节）。
+ */
+void writePixels(QTextStream &out, const QString &name, const QImage &image) {
+    out << "alignas(16) const uchar " << name << "[] = {";
+    const qsizetype bytes = image.sizeInBytes();
+    const uchar *data = image.constBits();
+    for (qsizetype i = 0; i < bytes; ++i) {
+        out << (i % 24 == 0 ? "\n    " : "") << int(data[i]) << ',';
+    }
+    out << "\n};\n";
+}
+
+/**
+ * 输出一张表：每张贴图一个 BakedAssets::Image，数组名为 prefix + 下标。
+ */
+void writeTable(QTextStream &out, const char *table, const QString &prefix,
+                const QStringList &paths, const std::vector<QImage> &images) {
+    out << "const BakedAssets::Image " << table << "[] = {\n";
+    for (size_t i = 0; i < images.size(); ++i) {
+        const QImage &img = images[i];
+        out << "    {\"" << paths[static_cast<qsizetype>(i)] << "\", " << img.width() << ", " << img.height() << ", "
+            << img.bytesPerLine() << ", " << (img.isNull() ? QStringLiteral("nullptr") : prefix + QString::number(static_cast<int>(i)))
+            << "},\n";
+    }
+    out << "};\n";
+}
+
+} // namespace
+
+/**
+ * 资源烘焙工具（构建步骤，由 CMake 在编译 dino_core 前运行）：
+ * 从 qrc 解码全部 PNG，按 SpriteCache 的规则缩放，连同渲染层直接使用的 :/other 贴图
+ * 一起写成 C++ 源文件中的原始像素数组。游戏启动时零拷贝包装这些数组，不再解码 PNG。
+ * 用法：dino_bake <输出 .cpp>
+ */
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    const QStringList args = QCoreApplication::arguments();
+    if (args.size() != 2) {
+        std::fprintf(stderr, "usage: dino_bake <output.cpp>\n");
+        return 2;
+    }
+
+    // bakedassets_none.cpp is linked here, so this decodes from PNG
+    const SpriteCache cache;
+    QStringList spritePaths;
+    std::vector<QImage> sprites;
+    for (int i = 0; i < cache.size(); ++i) {
+        spritePaths << QString::fromLatin1(cache.entry(i).source);
+        sprites.push_back(cache.entry(i).image.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+    }
+
+    QStringList imagePaths;
+    std::vector<QImage> images;
+    for (const QString &name : QDir(QStringLiteral(":/other")).entryList(QDir::Files, QDir::Name)) {
+        const QString path = QStringLiteral(":/other/") + name;
+        const QImage img(path);
+        if (!img.isNull()) {
+            imagePaths << path;
+            images.push_back(img.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+        }
+    }
+
+    QString source;
+    QTextStream out(&source);
+    out << "// Generated by dino_bake from resources/resources.qrc. Do not edit.\n"
+        << "#include \"bakedassets.h\"\n\nnamespace {\n\n";
+    for (size_t i = 0; i < sprites.size(); ++i) {
+        if (!sprites[i].isNull()) {
+            writePixels(out, QStringLiteral("sprite%1").arg(static_cast<int>(i)), sprites[i]);
+        }
+    }
+    for (size_t i = 0; i < images.size(); ++i) {
+        writePixels(out, QStringLiteral("image%1").arg(static_cast<int>(i)), images[i]);
+    }
+    out << '\n';
+    writeTable(out, "spriteTable", QStringLiteral("sprite"), spritePaths, sprites);
+    writeTable(out, "imageTable", QStringLiteral("image"), imagePaths, images);
+    out << "\n} // namespace\n\nnamespace BakedAssets {\n"
+        << "const Image *const sprites = spriteTable;\n"
+        << "const int spriteCount = " << static_cast<int>(sprites.size()) << ";\n"
+        << "const Image *const images = imageTable;\n"
+        << "const int imageCount = " << static_cast<int>(images.size()) << ";\n"
+        << "} // namespace BakedAssets\n";
+    out.flush();
+
+    QSaveFile file(args.at(1));
+    const QByteArray bytes = source.toUtf8();
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text) || file.write(bytes) != bytes.size() || !file.commit()) {
+        std::fprintf(stderr, "dino_bake: cannot write %s\n", qPrintable(args.at(1)));
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,243 @@
+#include "autopilot.h"
+#include "gamerenderer.h"
+#include "gameworld.h"
+#include "gameconfig.h"
+#include "particlesystem.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+#include <QTextStream>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * 基准测试对 GameWorld 私有阶段的访问入口（GameWorld 中声明为友元）。
+ */
+struct GameWorldBench {
+    static void spawnCactus(GameWorld &world) { world.spawnCactus(); }
+    static bool checkCollision(const GameWorld &world) { return world.checkCollision(); }
+    static ObstacleStore &obstacles(GameWorld &world) { return world.obstacles; }
+};
+
+namespace {
+
+struct Options {
+    int warmup = 3;   // 丢弃的预热轮数
+    int reps = 15;    // 计入统计的轮数
+    QString filter;   // 只运行名称包含该子串的项
+};
+
+struct Result {
+    double mean = 0;   // 每次操作平均耗时（纳秒）
+    double stddev = 0; // 各轮之间的标准差（纳秒）
+    double min = 0;
+    double median = 0;
+    double max = 0;
+};
+
+/**
+ * 运行一项基准：每轮先调用 setup（不计时），再计时 iterations 次 body，
+ * 记录每次操作的平均耗时。预热轮不计入结果。
+ */
+Result measure(const Options &options, int iterations, const std::function<void()> &setup,
+               const std::function<void()> &body) {
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(options.reps));
+    for (int rep = -options.warmup; rep < options.reps; ++rep) {
+        setup();
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; ++i) {
+            body();
+        }
+        const double perOp = double(timer.nsecsElapsed()) / iterations;
+        if (rep >= 0) {
+            samples.push_back(perOp);
+        }
+    }
+
+    Result r;
+    if (samples.empty()) {
+        return r;
+    }
+    double sum = 0;
+    for (double s : samples) {
+        sum += s;
+    }
+    r.mean = sum / samples.size();
+    double var = 0;
+    for (double s : samples) {
+        var += (s - r.mean) * (s - r.mean);
+    }
+    r.stddev = samples.size() > 1 ? std::sqrt(var / (samples.size() - 1)) : 0.0;
+    std::sort(samples.begin(), samples.end());
+    r.min = samples.front();
+    r.max = samples.back();
+    r.median = samples[samples.size() / 2];
+    return r;
+}
+
+/**
+ * 把 n 个（不超过存储容量）仙人掌均匀铺在恐龙前方（最近一个与恐龙包围盒相交但不接触像素），
+ * 使碰撞检测既走粗判也走掩码判定。
+ */
+void placeCacti(GameWorld &world, int n) {
+    ObstacleStore &obstacles = GameWorldBench::obstacles(world);
+    obstacles.clear();
+    const SpriteCache &sprites = world.getSprites();
+    const QRect dinoRect = world.getDino().boundingRect();
+    for (int i = 0; i < n; ++i) {
+        const SpriteCache::Handle h = sprites.cactus(i % SpriteCache::cactusKinds, i % SpriteCache::scaleBuckets);
+        const QImage &img = sprites.entry(h).image;
+        const int x = i == 0 ? dinoRect.right() - 2 : dinoRect.right() + 40 + i * (GameConfig::windowWidth / std::max(n, 1));
+        const int y = GameConfig::groundY - img.height() + GameConfig::groundAlignOffset;
+        obstacles.push(h, x, y, img.width(), img.height());
+    }
+}
+
+} // namespace
+
+/**
+ * 基准测试入口：在离屏平台上计时碰撞检测、障碍生成、单步模拟与整帧绘制，
+ * 以 CSV 输出每项的每次操作耗时统计（纳秒），便于不同构建之间比较。
+ */
+int main(int argc, char *argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen"); // no display needed
+    }
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName("dino_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("DinoGame benchmark suite");
+    parser.addHelpOption();
+    QCommandLineOption warmupOption("warmup", "Warm-up repetitions (discarded).", "n", "3");
+    parser.addOption(warmupOption);
+    QCommandLineOption repsOption("reps", "Measured repetitions.", "n", "15");
+    parser.addOption(repsOption);
+    QCommandLineOption filterOption("filter", "Only run benchmarks whose name contains this text.", "text");
+    parser.addOption(filterOption);
+    QCommandLineOption outOption("out", "Also write the results to a CSV file.", "file");
+    parser.addOption(outOption);
+    parser.process(app);
+
+    Options options;
+    options.warmup = std::max(parser.value(warmupOption).toInt(), 0);
+    options.reps = std::max(parser.value(repsOption).toInt(), 1);
+    options.filter = parser.value(filterOption);
+
+    QString csv;
+    QTextStream out(&csv);
+    out << "benchmark,iterations,reps,mean_ns,stddev_ns,min_ns,median_ns,max_ns\n";
+    const auto run = [&](const QString &name, int iterations, const std::function<void()> &setup,
+                         const std::function<void()> &body) {
+        if (!options.filter.isEmpty() && !name.contains(options.filter)) {
+            return;
+        }
+        const Result r = measure(options, iterations, setup, body);
+        out << name << ',' << iterations << ',' << options.reps << ','
+            << QString::number(r.mean, 'f', 1) << ',' << QString::number(r.stddev, 'f', 1) << ','
+            << QString::number(r.min, 'f', 1) << ',' << QString::number(r.median, 'f', 1) << ','
+            << QString::number(r.max, 'f', 1) << '\n';
+    };
+
+    auto sprites = std::make_shared<const SpriteCache>();
+    GameWorld world(sprites);
+    volatile bool sink = false; // keep results alive
+
+    // sprite cache construction: the one-off decode + scale cost moved out of the frame loop
+    run(QStringLiteral("sprite_cache_build"), 1, [] {}, [] { SpriteCache cache; });
+
+    for (int n : {1, 8, 32, ObstacleStore::capacity}) {
+        run(QStringLiteral("check_collision_n%1").arg(n), 10000,
+            [&] { world.reset(1); world.start(); placeCacti(world, n); },
+            [&] { sink = GameWorldBench::checkCollision(world); });
+    }
+
+    // store capacity bounds the batch; clear before each spawn so none are dropped
+    run(QStringLiteral("spawn_cactus"), 1000,
+        [&] { world.reset(1); },
+        [&] {
+            if (GameWorldBench::obstacles(world).full()) {
+                GameWorldBench::obstacles(world).clear();
+            }
+            GameWorldBench::spawnCactus(world);
+        });
+
+    run(QStringLiteral("obstacle_advance"), 100000,
+        [&] { world.reset(1); placeCacti(world, 8); },
+        [&] { GameWorldBench::obstacles(world).advance(1); });
+
+    // one simulation tick: step + snapshot, as done by GameWindow::gameLoop
+    WorldSnapshot snapshot;
+    run(QStringLiteral("game_tick"), 10000,
+        [&] { world.reset(1); world.start(); },
+        [&] {
+            if (world.gameOver()) {
+                world.reset(1);
+                world.start();
+            }
+            world.step(autopilot(world));
+            world.snapshot(snapshot);
+        });
+
+    // full frame render into an offscreen image
+    GameRenderer renderer(*sprites);
+    QImage target(GameConfig::windowWidth, GameConfig::windowHeight, QImage::Format_ARGB32_Premultiplied);
+    WorldSnapshot previous;
+    run(QStringLiteral("render_frame"), 200,
+        [&] {
+            world.reset(1);
+            world.start();
+            for (int i = 0; i < 300 && !world.gameOver(); ++i) {
+                world.step(autopilot(world)); // populate obstacles
+            }
+            world.snapshot(previous);
+            world.step(autopilot(world));
+            world.snapshot(snapshot);
+        },
+        [&] {
+            QPainter painter(&target);
+            renderer.render(painter, previous, snapshot, 0.5);
+        });
+
+    // particle pool under load: one 60 Hz integrate + cull pass, and one bucketed draw;
+    // lifetimes outlast a whole round so the live count stays at n
+    ParticleSystem particles;
+    ParticleSystem::Emitter burst;
+    burst.origin = QPointF(GameConfig::windowWidth / 2.0, GameConfig::groundY / 2.0);
+    burst.spread = QPointF(GameConfig::windowWidth / 3.0, GameConfig::groundY / 3.0);
+    burst.velocityJitter = QPointF(30, 30);
+    burst.life = 10.0f;
+    const std::array<QColor, ParticleSystem::KindCount> colors = {QColor(160, 160, 160), QColor(83, 83, 83)};
+    for (int n : {1000, 10000, GameConfig::particleCapacity}) {
+        run(QStringLiteral("particle_update_n%1").arg(n), 100,
+            [&] { particles.clear(); particles.spawn(burst, n); },
+            [&] { particles.update(1.0f / GameConfig::simulationHz); });
+        run(QStringLiteral("particle_draw_n%1").arg(n), 20,
+            [&] { particles.clear(); particles.spawn(burst, n); },
+            [&] {
+                QPainter painter(&target);
+                particles.draw(painter, colors);
+            });
+    }
+
+    out.flush();
+    QTextStream(stdout) << csv;
+    if (parser.isSet(outOption)) {
+        QFile file(parser.value(outOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)
+            || file.write(csv.toUtf8()) != csv.toUtf8().size()) {
+            QTextStream(stdout) << "failed to write results\n";
+            return 1;
+        }
+    }
+    return 0;
+}
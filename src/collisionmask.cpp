@@ -0,0 +1,105 @@
+#include "collisionmask.h"
+#include <QImage>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+#if defined(__SSE2__)
+/**
+ * 从 bit 偏移处一次取出 128 个像素位（两个相邻的 64 位窗口）。
+ * 左移 64 位在 SSE2 中结果为 0，因此对齐时无需分支。
+ */
+inline __m128i fetch128(const quint64 *row, int bit) {
+    const int word = bit >> 6;
+    const __m128i shift = _mm_cvtsi32_si128(bit & 63);
+    const __m128i back = _mm_cvtsi32_si128(64 - (bit & 63));
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + word));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + word + 1));
+    return _mm_or_si128(_mm_srl_epi64(lo, shift), _mm_sll_epi64(hi, back));
+}
+#endif
+
+} // namespace
+
+/**
+ * 从图片构建掩码：转换一次 ARGB32，逐行把 alpha > 0 的像素置位。
+ */
+CollisionMask::CollisionMask(const QImage &image) {
+    if (image.isNull()) {
+        return;
+    }
+    const QImage argb = image.convertToFormat(QImage::Format_ARGB32);
+    w = argb.width();
+    h = argb.height();
+    stride = (w + 63) / 64 + 2;
+    bits.assign(static_cast<std::size_t>(stride) * h, 0);
+    for (int y = 0; y < h; ++y) {
+        const QRgb *src = reinterpret_cast<const QRgb *>(argb.constScanLine(y));
+        quint64 *dst = bits.data() + static_cast<std::size_t>(y) * stride;
+        for (int x = 0; x < w; ++x) {
+            if (qAlpha(src[x]) > 0) {
+                dst[x >> 6] |= quint64(1) << (x & 63);
+            }
+        }
+    }
+}
+
+quint64 CollisionMask::fetch(const quint64 *row, int bit) {
+    const int word = bit >> 6;
+    const int shift = bit & 63;
+    if (shift == 0) {
+        return row[word];
+    }
+    return (row[word] >> shift) | (row[word + 1] << (64 - shift));
+}
+
+/**
+ * 计算屏幕空间重叠区域后逐行比较：每次取双方对齐后的 64 位窗口做按位与，
+ * 宽精灵（重叠宽度 >= 128）在支持 SSE2 时每次比较 128 位。
+ */
+bool CollisionMask::overlaps(const CollisionMask &a, const QPoint &aPos,
+                             const CollisionMask &b, const QPoint &bPos) {
+    if (a.isNull() || b.isNull()) {
+        return false;
+    }
+    const int left = std::max(aPos.x(), bPos.x());
+    const int top = std::max(aPos.y(), bPos.y());
+    const int right = std::min(aPos.x() + a.w, bPos.x() + b.w);   // exclusive
+    const int bottom = std::min(aPos.y() + a.h, bPos.y() + b.h);  // exclusive
+    if (left >= right || top >= bottom) {
+        return false;
+    }
+
+    const int width = right - left;
+    const int ax = left - aPos.x();
+    const int bx = left - bPos.x();
+    for (int y = top; y < bottom; ++y) {
+        const quint64 *ra = a.row(y - aPos.y());
+        const quint64 *rb = b.row(y - bPos.y());
+        int t = 0;
+#if defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        for (; t + 128 <= width; t += 128) {
+            const __m128i m = _mm_and_si128(fetch128(ra, ax + t), fetch128(rb, bx + t));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(m, zero)) != 0xFFFF) {
+                return true;
+            }
+        }
+#endif
+        for (; t < width; t += 64) {
+            quint64 m = fetch(ra, ax + t) & fetch(rb, bx + t);
+            const int remain = width - t;
+            if (remain < 64) {
+                m &= (quint64(1) << remain) - 1; // drop bits past the overlap
+            }
+            if (m != 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,57 @@
+#ifndef COLLISIONMASK_H
+#define COLLISIONMASK_H
+
+#include <QPoint>
+#include <QtGlobal>
+#include <cstddef>
+#include <vector>
+
+class QImage;
+
+/**
+ * 像素级碰撞掩码：把一帧贴图的 alpha 通道打包成每像素 1 bit 的行位图。
+ * 只在加载或缩放贴图时构建一次，碰撞时用 64 位按位与逐行比较，
+ * 不再需要 QPixmap -> QImage 转换或逐像素读取。
+ */
+class CollisionMask {
+public:
+    /** 构造空掩码。 */
+    CollisionMask() = default;
+
+    /**
+     * 从图片构建掩码，alpha > 0 的像素视为实心。
+     * @param image 已缩放到绘制尺寸的贴图。
+     */
+    explicit CollisionMask(const QImage &image);
+
+    [[nodiscard]] bool isNull() const { return bits.empty(); }
+    [[nodiscard]] int width() const { return w; }
+    [[nodiscard]] int height() const { return h; }
+
+    /**
+     * 判断两个掩码放置在屏幕上时是否有实心像素重叠。
+     * @param a 第一个掩码。
+     * @param aPos a 的左上角屏幕坐标。
+     * @param b 第二个掩码。
+     * @param bPos b 的左上角屏幕坐标。
+     * @return true 表示至少一个像素双方都为实心。
+     */
+    static bool overlaps(const CollisionMask &a, const QPoint &aPos,
+                         const CollisionMask &b, const QPoint &bPos);
+private:
+    /**
+     * 从 bit 偏移 bit 处取出连续 64 个像素位（跨字时拼接相邻字）。
+     * @param row 行起始指针。
+     * @param bit 行内像素偏移。
+     */
+    static quint64 fetch(const quint64 *row, int bit);
+
+    [[nodiscard]] const quint64 *row(int y) const { return bits.data() + static_cast<std::size_t>(y) * stride; }
+
+    int w = 0;      // 宽度（像素）
+    int h = 0;      // 高度（像素）
+    int stride = 0; // 每行字数（含 2 个零填充字，便于越过行尾读取）
+    std::vector<quint64> bits; // 行优先位图，bit i 对应 x = 64 * word + i
+};
+
+#endif // COLLISIONMASK_H
@@ -0,0 +1,95 @@
+#include "daynightcycle.h"
+#include "gameconfig.h"
+#include <QPainter>
+#include <algorithm>
+
+namespace {
+
+/** 配色级别对应的插值系数。 */
+float paletteT(int level) {
+    return GameConfig::nightPaletteLevels > 1
+        ? static_cast<float>(level) / (GameConfig::nightPaletteLevels - 1)
+        : 0.0f;
+}
+
+int invertChannel(int value, float t) {
+    return qRound(value + (255 - 2 * value) * t);
+}
+
+} // namespace
+
+/**
+ * 构建查找表：背景色逐帧精确插值，配色与云朵级别按量化级数取整。
+ */
+DayNightCycle::DayNightCycle() : table(static_cast<size_t>(GameConfig::dayNightCycleFrames)) {
+    const QColor day = QColor::fromRgb(GameConfig::dayBackgroundRgb);
+    const QColor night = QColor::fromRgb(GameConfig::nightBackgroundRgb);
+    for (int pos = 0; pos < GameConfig::dayNightCycleFrames; ++pos) {
+        const float t = transitionAlpha(pos);
+        State &s = table[static_cast<size_t>(pos)];
+        s.background = interpolateColor(day, night, t).rgb();
+        s.paletteLevel = qRound(t * (GameConfig::nightPaletteLevels - 1));
+        s.cloudLevel = qRound((1.0f - t) * GameConfig::cloudFadeLevels); // cloudAlpha = 1 - t
+    }
+}
+
+const DayNightCycle::State &DayNightCycle::at(int frameCount) const {
+    return table[static_cast<size_t>(std::max(frameCount, 0) % GameConfig::dayNightCycleFrames)];
+}
+
+float DayNightCycle::transitionAlpha(int cyclePosition) {
+    const int duskStart = GameConfig::dayDurationFrames;
+    const int nightStart = duskStart + GameConfig::transitionFrames;
+    const int dawnStart = nightStart + GameConfig::nightDurationFrames;
+    const int dawnEnd = dawnStart + GameConfig::transitionFrames;
+    if (cyclePosition < duskStart || cyclePosition >= dawnEnd) {
+        return 0.0f; // day
+    }
+    if (cyclePosition < nightStart) {
+        return static_cast<float>(cyclePosition - duskStart) / GameConfig::transitionFrames;
+    }
+    if (cyclePosition < dawnStart) {
+        return 1.0f; // night
+    }
+    return 1.0f - static_cast<float>(cyclePosition - dawnStart) / GameConfig::transitionFrames;
+}
+
+QColor DayNightCycle::interpolateColor(const QColor &from, const QColor &to, float alpha) {
+    return QColor(qRound(from.red() + (to.red() - from.red()) * alpha),
+                  qRound(from.green() + (to.green() - from.green()) * alpha),
+                  qRound(from.blue() + (to.blue() - from.blue()) * alpha));
+}
+
+QImage DayNightCycle::paletteImage(const QImage &source, int level) {
+    if (level <= 0 || source.isNull()) {
+        return source;
+    }
+    const float t = paletteT(level);
+    QImage img = source.convertToFormat(QImage::Format_ARGB32);
+    for (int y = 0; y < img.height(); ++y) {
+        auto *line = reinterpret_cast<QRgb *>(img.scanLine(y));
+        for (int x = 0; x < img.width(); ++x) {
+            const QRgb p = line[x];
+            line[x] = qRgba(invertChannel(qRed(p), t), invertChannel(qGreen(p), t), invertChannel(qBlue(p), t), qAlpha(p));
+        }
+    }
+    return img.convertToFormat(source.format());
+}
+
+QColor DayNightCycle::paletteColor(const QColor &color, int level) {
+    const float t = paletteT(level);
+    return QColor(invertChannel(color.red(), t), invertChannel(color.green(), t), invertChannel(color.blue(), t), color.alpha());
+}
+
+QImage DayNightCycle::fadedImage(const QImage &source, int level) {
+    if (source.isNull()) {
+        return source;
+    }
+    QImage img(source.size(), QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::transparent);
+    QPainter painter(&img);
+    painter.setOpacity(static_cast<qreal>(level) / GameConfig::cloudFadeLevels);
+    painter.drawImage(0, 0, source);
+    painter.end();
+    return img;
+}
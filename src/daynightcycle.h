@@ -0,0 +1,72 @@
+#ifndef DAYNIGHTCYCLE_H
+#define DAYNIGHTCYCLE_H
+
+#include <QColor>
+#include <QImage>
+#include <vector>
+
+/**
+ * 昼夜周期查找表：启动时为周期内的每一帧预先算好背景色、贴图配色级别与云朵淡化级别，
+ * 绘制时按 frameCount 直接查表。贴图配色与云朵透明度量化为有限级别，
+ * 每级对应一份预先生成的图集或预淡化的云朵帧，过渡期一帧的开销与白天相同。
+ *
+ * 周期划分（帧）：白天 dayDurationFrames → 过渡 transitionFrames → 黑夜 nightDurationFrames
+ * → 过渡 transitionFrames，总长 dayNightCycleFrames。
+ */
+class DayNightCycle {
+public:
+    struct State {
+        QRgb background;  // 背景色
+        int paletteLevel; // 贴图配色级别 [0, nightPaletteLevels)，0 为白天原色
+        int cloudLevel;   // 云朵淡化级别 [0, cloudFadeLevels]，0 为隐藏
+    };
+
+    /** 构建整个周期的查找表。 */
+    DayNightCycle();
+
+    /**
+     * 某一帧的昼夜状态。
+     * @param frameCount 本局已模拟帧数。
+     */
+    [[nodiscard]] const State &at(int frameCount) const;
+
+    /**
+     * 周期内某位置的过渡进度：白天 0，黑夜 1，过渡期线性变化。
+     * @param cyclePosition 周期内帧位置 [0, dayNightCycleFrames)。
+     */
+    static float transitionAlpha(int cyclePosition);
+
+    /**
+     * 颜色线性插值。
+     * @param from 起始颜色。
+     * @param to 目标颜色。
+     * @param alpha 插值系数 0-1。
+     */
+    static QColor interpolateColor(const QColor &from, const QColor &to, float alpha);
+
+    /**
+     * 生成某配色级别的贴图：每个像素的 RGB 向其反色插值，alpha 不变。
+     * 深色精灵在黑夜背景上变为浅色，仅在启动时调用。
+     * @param source 原图。
+     * @param level 配色级别 [0, nightPaletteLevels)。
+     */
+    static QImage paletteImage(const QImage &source, int level);
+
+    /**
+     * 单个颜色在某配色级别下的颜色（用于 HUD 文字等非图集内容）。
+     * @param color 白天颜色。
+     * @param level 配色级别。
+     */
+    static QColor paletteColor(const QColor &color, int level);
+
+    /**
+     * 生成预淡化的云朵帧：alpha 乘以 level / cloudFadeLevels。
+     * @param source 云朵原图。
+     * @param level 淡化级别 [1, cloudFadeLevels]。
+     */
+    static QImage fadedImage(const QImage &source, int level);
+private:
+    std::vector<State> table; // 每帧一项，长度 dayNightCycleFrames
+};
+
+#endif // DAYNIGHTCYCLE_H
@@ -1,68 +1,44 @@
 #include "dino.h"
 #include "gameconfig.h"
-#include <QPainter>
-#include <QDir>
 
 /**
- * 构造函数：加载图片并初始化位置与状态。
+ * 构造函数：初始化位置与状态。
  */
-Dino::Dino(QObject *parent) : QObject(parent), x(50), y(0), vy(0), isJumping(false), isDucking(false), isDead(false), hasStarted(false), animToggle(false), animCounter(0) {
-    dinoImg = QPixmap(":/dino/DinoRun1.png"); // 使用 Qt 资源系统
-    dinoImg2 = QPixmap(":/dino/DinoRun2.png");
-    duckImg = QPixmap(":/dino/DinoDuck1.png");
-    duckImg2 = QPixmap(":/dino/DinoDuck2.png");
-    deadImg = QPixmap(":/dino/DinoDead.png");
-    startImg = QPixmap(":/dino/DinoStart.png");
-    jumpImg = QPixmap(":/dino/DinoJump.png");
+Dino::Dino(QObject *parent) : QObject(parent), x(GameConfig::dinoX), y(0), vy(0), isJumping(false), landed(false), isDucking(false), isDead(false), hasStarted(false), animToggle(false), animCounter(0) {
     groundY = GameConfig::dinoGroundY; // 地面高度
     y = groundY;
 }
 
 /**
- * 绘制恐龙，根据状态选择不同的目标矩形。
+ * 返回某帧的绘制尺寸（下蹲帧更矮）。
  */
-void Dino::draw(QPainter *painter) {
-    QPixmap current;
-    QRect dest;
-
-    if (isDead) {
-        current = deadImg;
-        dest = QRect(x, y, GameConfig::dinoWidth, GameConfig::dinoHeight);
-    } else if (!hasStarted) {
-        current = startImg;
-        dest = QRect(x, y, GameConfig::dinoWidth, GameConfig::dinoHeight);
-    } else if (isJumping) {
-        current = jumpImg;
-        dest = QRect(x, y, GameConfig::dinoWidth, GameConfig::dinoHeight);
-    } else if (isDucking) {
-        current = animToggle ? duckImg2 : duckImg;
-        dest = QRect(x, y + GameConfig::dinoDuckYOffset, GameConfig::dinoWidth, GameConfig::dinoDuckHeight);
-    } else {
-        current = animToggle ? dinoImg2 : dinoImg;
-        dest = QRect(x, y, GameConfig::dinoWidth, GameConfig::dinoHeight);
+QSize Dino::frameSize(Frame frame) {
+    if (frame == FrameDuck1 || frame == FrameDuck2) {
+        return {GameConfig::dinoWidth, GameConfig::dinoDuckHeight};
     }
-
-    painter->drawPixmap(dest, current);
+    return {GameConfig::dinoWidth, GameConfig::dinoHeight};
 }
 
 /**
  * 每帧更新位置与速度；处理着陆逻辑，并更新动画计数器。
  */
 void Dino::update() {
+    landed = false;
     if (isJumping) {
         y += vy;
-        vy += gravity;
+        vy += GameConfig::dinoGravity;
         if (y >= groundY) {
             y = groundY;
             isJumping = false;
+            landed = true;
             vy = 0;
         }
     }
 
     if (!isDead && hasStarted) {
-        // 动画切换：简单计数器，每 8 帧切换一次
+        // 动画切换：简单计数器，每 dinoAnimationFrames 帧切换一次
         animCounter++;
-        if (animCounter >= 8) {
+        if (animCounter >= GameConfig::dinoAnimationFrames) {
             animCounter = 0;
             animToggle = !animToggle;
         }
@@ -75,7 +51,7 @@ void Dino::update() {
 void Dino::jump() {
     if (!isJumping && !isDead) {
         isJumping = true;
-        vy = jumpSpeed;
+        vy = GameConfig::dinoJumpSpeed;
     }
 }
 
@@ -125,6 +101,7 @@ QRect Dino::boundingRect() const {
  */
 void Dino::reset() {
     isJumping = false;
+    landed = false;
     isDucking = false;
     isDead = false;
     hasStarted = false;
@@ -135,31 +112,25 @@ void Dino::reset() {
 }
 
 /**
- * 获取当前绘制帧与目标矩形，用于像素级碰撞。
- * @param outPixmap 输出：当前贴图。
+ * 获取当前绘制帧与目标矩形，用于绘制与像素级碰撞。
+ * @param outFrame 输出：当前帧索引。
  * @param outRect 输出：当前绘制矩形（屏幕坐标）。
  */
-void Dino::currentFrame(QPixmap &outPixmap, QRect &outRect) const {
-    QPixmap current;
-    QRect dest;
-
+void Dino::currentFrame(Frame &outFrame, QRect &outRect) const {
     if (isDead) {
-        current = deadImg;
-        dest = QRect(x, y, GameConfig::dinoWidth, GameConfig::dinoHeight);
+        outFrame = FrameDead;
+        outRect = QRect(x, y, GameConfig::dinoWidth, GameConfig::dinoHeight);
     } else if (!hasStarted) {
-        current = startImg;
-        dest = QRect(x, y, GameConfig::dinoWidth, GameConfig::dinoHeight);
+        outFrame = FrameStart;
+        outRect = QRect(x, y, GameConfig::dinoWidth, GameConfig::dinoHeight);
     } else if (isJumping) {
-        current = jumpImg;
-        dest = QRect(x, y, GameConfig::dinoWidth, GameConfig::dinoHeight);
+        outFrame = FrameJump;
+        outRect = QRect(x, y, GameConfig::dinoWidth, GameConfig::dinoHeight);
     } else if (isDucking) {
-        current = animToggle ? duckImg2 : duckImg;
-        dest = QRect(x, y + GameConfig::dinoDuckYOffset, GameConfig::dinoWidth, GameConfig::dinoDuckHeight);
+        outFrame = animToggle ? FrameDuck2 : FrameDuck1;
+        outRect = QRect(x, y + GameConfig::dinoDuckYOffset, GameConfig::dinoWidth, GameConfig::dinoDuckHeight);
     } else {
-        current = animToggle ? dinoImg2 : dinoImg;
-        dest = QRect(x, y, GameConfig::dinoWidth, GameConfig::dinoHeight);
+        outFrame = animToggle ? FrameRun2 : FrameRun1;
+        outRect = QRect(x, y, GameConfig::dinoWidth, GameConfig::dinoHeight);
     }
-
-    outPixmap = current;
-    outRect = dest;
 }
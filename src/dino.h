@@ -2,28 +2,50 @@
 #define DINO_H
 
 #include <QObject>
-#include <QPixmap>
-
-class QPainter;
-class QRect;
+#include <QRect>
+#include <QSize>
 
 /**
- * 简单的恐龙（玩家）类，负责绘制与基本物理（跳跃/下蹲）。
+ * 简单的恐龙（玩家）类，负责基本物理（跳跃/下蹲）与当前帧选择。
+ * 不持有任何贴图，绘制由渲染层按 Frame 索引完成，因此可用于无头仿真。
  */
 class Dino : public QObject {
     Q_OBJECT
 public:
+    /** 恐龙动画帧索引，渲染层按此索引选择贴图。 */
+    enum Frame {
+        FrameRun1 = 0, // 站立帧 1
+        FrameRun2,     // 站立帧 2
+        FrameDuck1,    // 下蹲帧 1
+        FrameDuck2,    // 下蹲帧 2
+        FrameDead,     // 死亡帧
+        FrameStart,    // 起始静止帧
+        FrameJump,     // 跳跃帧
+        FrameCount
+    };
+
+    /** 各帧贴图资源路径，索引与 Frame 一致。 */
+    static constexpr const char *framePaths[FrameCount] = {
+        ":/dino/DinoRun1.png",
+        ":/dino/DinoRun2.png",
+        ":/dino/DinoDuck1.png",
+        ":/dino/DinoDuck2.png",
+        ":/dino/DinoDead.png",
+        ":/dino/DinoStart.png",
+        ":/dino/DinoJump.png"
+    };
+
     /**
-     * 构造函数。
-     * @param parent Qt 对象父指针，可为空。
+     * 返回某帧的绘制尺寸（下蹲帧更矮）。
+     * @param frame 帧索引。
      */
-    explicit Dino(QObject *parent = nullptr);
+    static QSize frameSize(Frame frame);
 
     /**
-     * 绘制恐龙，根据当前状态选择帧。
-     * @param painter 画家对象，外部创建并传入。
+     * 构造函数。
+     * @param parent Qt 对象父指针，可为空。
      */
-    void draw(QPainter *painter);
+    explicit Dino(QObject *parent = nullptr);
 
     /**
      * 每帧更新恐龙位置与动画。
@@ -58,36 +80,34 @@ public:
      */
     [[nodiscard]] QRect boundingRect() const;
 
+    /** 是否在空中（跳跃中）。 */
+    [[nodiscard]] bool airborne() const { return isJumping; }
+
+    /** 最近一次 update() 是否刚好落地（用于落地特效）。 */
+    [[nodiscard]] bool justLanded() const { return landed; }
+
     /**
-     * 获取当前绘制帧与目标矩形，用于像素级碰撞。
-     * @param outPixmap 输出：当前贴图。
+     * 获取当前绘制帧与目标矩形，用于绘制与像素级碰撞。
+     * @param outFrame 输出：当前帧索引。
      * @param outRect 输出：当前绘制矩形（屏幕坐标）。
      */
-    void currentFrame(QPixmap &outPixmap, QRect &outRect) const;
+    void currentFrame(Frame &outFrame, QRect &outRect) const;
 
     /**
      * 重置恐龙状态到初始值。
      */
     void reset();
 private:
-    QPixmap dinoImg;   // 站立帧 1
-    QPixmap duckImg;   // 下蹲帧 1
-    QPixmap dinoImg2;  // 站立帧 2
-    QPixmap duckImg2;  // 下蹲帧 2
-    QPixmap deadImg;   // 死亡帧
-    QPixmap startImg;  // 起始静止帧
-    QPixmap jumpImg;   // 跳跃帧
     int x, y;          // 左上角坐标
     int vy;            // 垂直速度
     bool isJumping;    // 是否正在跳跃
+    bool landed;       // 最近一次 update() 是否落地
     bool isDucking;    // 是否正在下蹲
     bool isDead;       // 是否死亡
     bool hasStarted;   // 是否已开始游戏
     bool animToggle;   // 动画帧切换标志
     int animCounter;   // 动画计数器
     int groundY;       // 地面基准高度
-    const int jumpSpeed = -16; // 起跳初速度
-    const int gravity = 1;     // 重力加速度
 };
 
 #endif // DINO_H
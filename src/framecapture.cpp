@@ -0,0 +1,216 @@
+#include "framecapture.h"
+#include "autopilot.h"
+#include "gameconfig.h"
+#include "gamerenderer.h"
+#include "gameworld.h"
+#include "inputlog.h"
+#include <QByteArray>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QMutex>
+#include <QPainter>
+#include <QSemaphore>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <algorithm>
+#include <map>
+#include <memory>
+
+namespace {
+
+/**
+ * 原始 RGBA 输出：编码线程乱序完成，按帧号排队后由录制线程顺序写出。
+ * 一帧写出后才归还它占用的在途名额，某一帧编码卡住时后续帧最多积压到名额用完，内存有界。
+ */
+class OrderedWriter {
+public:
+    /**
+     * @param file 输出文件。
+     * @param inFlight 在途帧名额，每写出一帧归还一个。
+     */
+    OrderedWriter(QFile &file, QSemaphore &inFlight) : file(file), inFlight(inFlight) {}
+
+    /** 编码线程提交一帧。 */
+    void submit(int frame, QByteArray data) {
+        QMutexLocker locker(&mutex);
+        ready.emplace(frame, std::move(data));
+        arrived.wakeOne();
+    }
+
+    /**
+     * 写出所有已按顺序就绪的帧。
+     * @param wait 为 true 时先等到下一帧就绪（调用方须保证它已在编码中）。
+     * @return 写入失败返回 false。
+     */
+    bool drain(bool wait) {
+        for (;;) {
+            QByteArray data;
+            {
+                QMutexLocker locker(&mutex);
+                auto it = ready.find(next);
+                while (wait && it == ready.end()) {
+                    arrived.wait(&mutex);
+                    it = ready.find(next);
+                }
+                if (it == ready.end()) {
+                    return true;
+                }
+                data = std::move(it->second);
+                ready.erase(it);
+            }
+            wait = false;
+            if (file.write(data) != data.size()) {
+                return false;
+            }
+            ++next;
+            inFlight.release();
+        }
+    }
+private:
+    QFile &file;
+    QSemaphore &inFlight;
+    QMutex mutex;
+    QWaitCondition arrived;          // 有新帧提交
+    std::map<int, QByteArray> ready; // 已编码、等待写出的帧
+    int next = 0;                    // 下一个要写出的帧号
+};
+
+} // namespace
+
+FrameCapture::FrameCapture(const Options &options) : options(options) {
+}
+
+/**
+ * 录制主循环：世界推进与绘制在本线程顺序进行（保证确定性），
+ * 每帧的图片拷贝交给线程池编码；信号量限制在途帧数（原始流的帧写出后才归还名额），
+ * 任何一帧编码卡住时内存都不会随积压增长。
+ */
+int FrameCapture::run() {
+    QTextStream err(stderr);
+    const bool raw = options.output == QLatin1String("-") || options.output.endsWith(QLatin1String(".rgba"));
+
+    InputLog log;
+    const bool replaying = !options.replay.isEmpty();
+    if (replaying && !log.load(options.replay)) {
+        err << "failed to read input log " << options.replay << '\n';
+        return 1;
+    }
+
+    GameWorld world;
+    const QString course = options.course.isEmpty() ? log.getCourse() : options.course;
+    if (!world.loadCourse(course)) {
+        err << "failed to read course file " << course << '\n';
+        return 1;
+    }
+
+    QFile rawFile;
+    if (raw) {
+        bool ok;
+        if (options.output == QLatin1String("-")) {
+            ok = rawFile.open(stdout, QIODevice::WriteOnly);
+        }
+        else {
+            rawFile.setFileName(options.output);
+            ok = rawFile.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        }
+        if (!ok) {
+            err << "failed to open " << options.output << '\n';
+            return 1;
+        }
+    }
+    else if (!QDir().mkpath(options.output)) {
+        err << "failed to create directory " << options.output << '\n';
+        return 1;
+    }
+    QThreadPool pool;
+    pool.setMaxThreadCount(options.threads > 0 ? options.threads : QThread::idealThreadCount());
+    QSemaphore inFlight(pool.maxThreadCount() * 2); // frames encoding or waiting to be written
+    OrderedWriter writer(rawFile, inFlight);
+    QAtomicInt failures = 0;
+
+    GameRenderer renderer(world.getSprites());
+    quint32 runSeed = replaying ? log.getSeed() : options.seed;
+    const auto restart = [&]() {
+        if (replaying || options.seeded) {
+            world.reset(runSeed++);
+        }
+        else {
+            world.reset();
+        }
+        world.start();
+        log.rewind();
+    };
+    restart();
+
+    WorldSnapshot snapshot;
+    QImage canvas(GameConfig::windowWidth, GameConfig::windowHeight, QImage::Format_ARGB32_Premultiplied);
+    QElapsedTimer clock;
+    clock.start();
+    int frame = 0;
+    for (; frame < options.frames; ++frame) {
+        if (world.gameOver()) {
+            if (replaying) {
+                break; // the recorded run is over
+            }
+            restart();
+        }
+        world.step(replaying ? log.replay(static_cast<quint32>(world.getFrameCount())) : autopilot(world));
+        world.snapshot(snapshot);
+        {
+            QPainter painter(&canvas);
+            renderer.render(painter, snapshot);
+        }
+
+        if (raw) {
+            // slots come back only as frames are written: while none is free, write the oldest frame
+            bool ok = true;
+            while (ok && !inFlight.tryAcquire()) {
+                ok = writer.drain(true);
+            }
+            if (!ok) {
+                failures.fetchAndAddRelaxed(1);
+                break;
+            }
+        }
+        else {
+            inFlight.acquire();
+        }
+        const QImage image = canvas.copy(); // the canvas is reused by the next frame
+        const QString path = raw ? QString() : QDir(options.output).filePath(QStringLiteral("frame_%1.png").arg(frame, 6, 10, QChar('0')));
+        pool.start([&, image, path, frame]() {
+            if (raw) {
+                const QImage rgba = image.convertToFormat(QImage::Format_RGBA8888);
+                writer.submit(frame, QByteArray(reinterpret_cast<const char *>(rgba.constBits()), rgba.sizeInBytes()));
+            }
+            else {
+                if (!image.save(path, "PNG")) {
+                    failures.fetchAndAddRelaxed(1);
+                }
+                inFlight.release(); // raw frames are released by the writer
+            }
+        });
+        if (raw && !writer.drain(false)) {
+            failures.fetchAndAddRelaxed(1);
+            break;
+        }
+    }
+    pool.waitForDone();
+    if (raw && !writer.drain(false)) {
+        failures.fetchAndAddRelaxed(1);
+    }
+    const qint64 elapsedNs = qMax<qint64>(clock.nsecsElapsed(), 1);
+
+    err << "captured frames: " << frame << '\n';
+    err << "encoder threads: " << pool.maxThreadCount() << '\n';
+    err << "elapsed ms: " << elapsedNs / 1000000.0 << '\n';
+    err << "frames/s: " << double(frame) * 1e9 / double(elapsedNs) << '\n';
+    if (failures.loadRelaxed() != 0) {
+        err << "failed to write " << failures.loadRelaxed() << " frame(s)\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * 离屏录制：在 offscreen 平台上以最高速度逐步推进世界，
+ * 每一步都用与 paintEvent 相同的 GameRenderer 绘制到 QImage，
+ * 编码（PNG 压缩或 RGBA 转换）交给线程池并行完成，最后报告吞吐量。
+ *
+ * 输出：
+ *   - PNG 序列：output 为目录，文件名 frame_000000.png 起；
+ *   - 原始 RGBA：output 为 "-"（标准输出，便于接 ffmpeg 管道）或以 .rgba 结尾的文件，
+ *     逐帧按顺序写入 windowWidth x windowHeight x 4 字节。
+ */
+class FrameCapture {
+public:
+    struct Options {
+        QString output;      // 输出目录、.rgba 文件或 "-"
+        int frames = 600;    // 录制帧数（每帧一个模拟步）
+        int threads = 0;     // 编码线程数，<=0 时使用 CPU 核数
+        bool seeded = false; // 是否固定种子
+        quint32 seed = 0;    // 固定种子（自动驾驶每局 +1）
+        QString replay;      // 输入日志；为空时使用自动驾驶
+        QString course;      // 障碍赛道文件；为空时随机生成（重放时默认用日志记录的赛道）
+    };
+
+    explicit FrameCapture(const Options &options);
+
+    /**
+     * 执行录制，进度与吞吐量写到标准错误（标准输出可能是视频管道）。
+     * @return 进程退出码，成功为 0。
+     */
+    int run();
+private:
+    Options options;
+};
+
+#endif // FRAMECAPTURE_H
@@ -0,0 +1,154 @@
+#include "frameprofiler.h"
+#include <QFile>
+#include <QFont>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QPointF>
+#include <QRect>
+#include <QString>
+#include <QTextStream>
+#include <algorithm>
+#include <vector>
+
+FrameProfiler::Scope::Scope(FrameProfiler *profiler, Phase phase) : profiler(profiler), phase(phase) {
+    if (profiler) {
+        timer.start();
+    }
+}
+
+FrameProfiler::Scope::~Scope() {
+    if (profiler) {
+        profiler->record(phase, timer.nsecsElapsed());
+    }
+}
+
+FrameProfiler::FrameProfiler() : rings(std::make_unique<Ring[]>(PhaseCount)) {
+}
+
+const char *FrameProfiler::phaseName(Phase phase) {
+    static const char *const names[PhaseCount] = {
+        "frame",
+        "step",
+        "dino_update",
+        "obstacle_update",
+        "collision",
+        "particle_update",
+        "paint",
+        "paint_background",
+        "paint_ground",
+        "paint_sprites",
+        "paint_particles",
+        "paint_hud",
+        "input_latency",
+        "startup"
+    };
+    return names[phase];
+}
+
+/**
+ * 写入：先写样本再以 release 语义推进 head，读者看到 head 后即可读到样本。
+ */
+void FrameProfiler::record(Phase phase, qint64 ns) {
+    Ring &ring = rings[phase];
+    const quint64 head = ring.head.load(std::memory_order_relaxed);
+    ring.samples[head & (capacity - 1)].store(ns, std::memory_order_relaxed);
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+int FrameProfiler::copyLatest(Phase phase, qint64 *out, int maxCount) const {
+    const Ring &ring = rings[phase];
+    const quint64 head = ring.head.load(std::memory_order_acquire);
+    const int count = static_cast<int>(std::min<quint64>({head, static_cast<quint64>(capacity), static_cast<quint64>(maxCount)}));
+    for (int i = 0; i < count; ++i) {
+        const quint64 index = head - static_cast<quint64>(count) + static_cast<quint64>(i);
+        out[i] = ring.samples[index & (capacity - 1)].load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+FrameProfiler::Stats FrameProfiler::stats(Phase phase, int window) const {
+    std::vector<qint64> values(static_cast<size_t>(std::clamp(window, 1, capacity)));
+    values.resize(static_cast<size_t>(copyLatest(phase, values.data(), static_cast<int>(values.size()))));
+
+    Stats s;
+    s.count = static_cast<int>(values.size());
+    if (values.empty()) {
+        return s;
+    }
+    s.max = *std::max_element(values.begin(), values.end());
+    auto p99 = values.begin() + (values.size() - 1) * 99 / 100;
+    std::nth_element(values.begin(), p99, values.end());
+    s.p99 = *p99;
+    auto p50 = values.begin() + (values.size() - 1) / 2;
+    std::nth_element(values.begin(), p50, p99);
+    s.p50 = *p50;
+    return s;
+}
+
+bool FrameProfiler::writeCsv(const QString &path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream out(&file);
+    out << "phase,sample,nanoseconds\n";
+    std::vector<qint64> values(capacity);
+    for (int p = 0; p < PhaseCount; ++p) {
+        const auto phase = static_cast<Phase>(p);
+        const int count = copyLatest(phase, values.data(), capacity);
+        for (int i = 0; i < count; ++i) {
+            out << phaseName(phase) << ',' << i << ',' << values[static_cast<size_t>(i)] << '\n';
+        }
+    }
+    out.flush();
+    return file.error() == QFileDevice::NoError;
+}
+
+/**
+ * 叠加层：左上角逐行列出各阶段统计，底部画最近帧间隔曲线（16.7ms 参考线）。
+ */
+void FrameProfiler::drawOverlay(QPainter &painter, const QRect &bounds) const {
+    painter.save();
+
+    QFont font = painter.font();
+    font.setPointSize(8);
+    painter.setFont(font);
+    QFontMetrics fm(font);
+    const int lineHeight = fm.height();
+
+    const int panelWidth = 300;
+    const int panelHeight = lineHeight * (PhaseCount + 1) + 8;
+    painter.fillRect(QRect(bounds.x() + 4, bounds.y() + 4, panelWidth, panelHeight), QColor(0, 0, 0, 160));
+    painter.setPen(Qt::white);
+    int y = bounds.y() + 8 + fm.ascent();
+    painter.drawText(bounds.x() + 8, y, QStringLiteral("phase              p50us   p99us   maxus"));
+    for (int p = 0; p < PhaseCount; ++p) {
+        y += lineHeight;
+        const auto phase = static_cast<Phase>(p);
+        const Stats s = stats(phase);
+        painter.drawText(bounds.x() + 8, y, QStringLiteral("%1 %2 %3 %4")
+                             .arg(QString::fromLatin1(phaseName(phase)), -16)
+                             .arg(s.p50 / 1000.0, 7, 'f', 1)
+                             .arg(s.p99 / 1000.0, 7, 'f', 1)
+                             .arg(s.max / 1000.0, 7, 'f', 1));
+    }
+
+    // frame interval graph
+    constexpr int graphSamples = 240;
+    constexpr qreal graphScaleNs = 50e6; // graph height = 50 ms
+    qint64 values[graphSamples];
+    const int count = copyLatest(PhaseFrame, values, graphSamples);
+    const QRect graph(bounds.right() - graphSamples - 8, bounds.y() + 4, graphSamples, 60);
+    painter.fillRect(graph, QColor(0, 0, 0, 160));
+    painter.setPen(QColor(255, 255, 0));
+    const qreal budgetY = graph.bottom() - graph.height() * (16.7e6 / graphScaleNs);
+    painter.drawLine(QPointF(graph.left(), budgetY), QPointF(graph.right(), budgetY));
+    painter.setPen(QColor(0, 255, 0));
+    for (int i = 0; i < count; ++i) {
+        const qreal h = std::min<qreal>(graph.height(), graph.height() * (values[i] / graphScaleNs));
+        const qreal x = graph.right() - (count - 1 - i);
+        painter.drawLine(QPointF(x, graph.bottom()), QPointF(x, graph.bottom() - h));
+    }
+
+    painter.restore();
+}
@@ -0,0 +1,115 @@
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <QElapsedTimer>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include <memory>
+
+class QPainter;
+class QRect;
+class QString;
+
+/**
+ * 帧分析器：为每个阶段维护一个无锁环形缓冲区，记录每次执行耗时（纳秒）。
+ * 每个阶段只允许一个线程写入，读取（叠加层统计、CSV 导出）可在任意线程进行，
+ * 读取期间被覆盖的旧样本只影响统计精度，不会阻塞写入方。
+ */
+class FrameProfiler {
+public:
+    enum Phase {
+        PhaseFrame = 0,       // 两次 gameLoop 之间的间隔
+        PhaseStep,            // 整个模拟步
+        PhaseDinoUpdate,      // dino.update()
+        PhaseObstacleUpdate,  // updateObstacles()
+        PhaseCollision,       // checkCollision()
+        PhaseParticleUpdate,  // ParticleSystem::update()（界面线程）
+        PhasePaint,           // 整个 paintEvent
+        PhasePaintBackground, // 背景色与视差层
+        PhasePaintGround,     // 地面
+        PhasePaintSprites,    // 障碍与恐龙
+        PhasePaintParticles,  // 粒子
+        PhasePaintHud,        // 分数与覆盖层
+        PhaseInputLatency,    // 按键事件时间戳到包含其效果的一帧绘制完成
+        PhaseStartup,         // 进程进入 main() 到第一帧绘制完成（每次启动一个样本）
+        PhaseCount
+    };
+
+    /** 每个阶段保留的样本数（2 的幂）。 */
+    static constexpr int capacity = 1 << 15;
+
+    struct Stats {
+        int count = 0;  // 参与统计的样本数
+        qint64 p50 = 0; // 中位数（纳秒）
+        qint64 p99 = 0; // 99 分位（纳秒）
+        qint64 max = 0; // 最大值（纳秒）
+    };
+
+    /**
+     * 作用域计时器：构造时开始计时，析构时记录到对应阶段。
+     * profiler 为空时不做任何事，便于在可选分析的代码路径中直接使用。
+     */
+    class Scope {
+    public:
+        Scope(FrameProfiler *profiler, Phase phase);
+        ~Scope();
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+    private:
+        FrameProfiler *profiler;
+        Phase phase;
+        QElapsedTimer timer;
+    };
+
+    FrameProfiler();
+
+    /** 阶段名称（用于叠加层与 CSV）。 */
+    static const char *phaseName(Phase phase);
+
+    /**
+     * 记录一个样本（单写者，无锁）。
+     * @param phase 阶段。
+     * @param ns 耗时（纳秒）。
+     */
+    void record(Phase phase, qint64 ns);
+
+    /**
+     * 统计最近若干样本的 p50/p99/max。
+     * @param phase 阶段。
+     * @param window 最多统计的最近样本数。
+     */
+    [[nodiscard]] Stats stats(Phase phase, int window = 600) const;
+
+    /**
+     * 把缓冲区内全部样本按 "phase,sample,nanoseconds" 写成 CSV。
+     * @param path 输出文件路径。
+     * @return 写入成功返回 true。
+     */
+    bool writeCsv(const QString &path) const;
+
+    /**
+     * 绘制叠加层：各阶段 p50/p99/max（微秒）与帧间隔曲线。
+     * @param painter 目标画家。
+     * @param bounds 叠加层所在区域（通常为整个窗口）。
+     */
+    void drawOverlay(QPainter &painter, const QRect &bounds) const;
+private:
+    struct Ring {
+        std::atomic<quint64> head{0};              // 已写入样本总数
+        std::array<std::atomic<qint64>, capacity> samples;
+    };
+
+    /**
+     * 按时间顺序复制最近的样本。
+     * @param phase 阶段。
+     * @param out 输出缓冲区。
+     * @param maxCount 最多复制的样本数。
+     * @return 实际复制的样本数。
+     */
+    int copyLatest(Phase phase, qint64 *out, int maxCount) const;
+
+    std::unique_ptr<Ring[]> rings; // 每阶段一个环形缓冲区（体积较大，放在堆上）
+};
+
+#endif // FRAMEPROFILER_H
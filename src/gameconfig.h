@@ -1,11 +1,14 @@
 #ifndef GAMECONFIG_H
 #define GAMECONFIG_H
 
+#include <QString>
+
 // 游戏全局配置常量，统一管理尺寸、速度、生成与昼夜参数
 namespace GameConfig {
     // 加密配置
     const QString ENCRYPTION_KEY = "ee7d5971-c06e-485d-8b09-abae73aef66d"; // 高分加密密钥
     const QString HIGHSCORE_FILE = "highscore.dat"; // 高分存储文件名
+    const QString HISTORY_FILE = "history.dat";     // 跑局历史文件名（只追加，内存映射）
 
     // 窗口与地面
     constexpr int windowWidth = 800;   // 窗口宽度（像素）
@@ -15,9 +18,16 @@ namespace GameConfig {
     constexpr int dinoGroundY = 220;    // 恐龙站立高度（dino.cpp 使用）
 
     // 速度与计分
-    constexpr int gameSpeed = 6;        // 地面/障碍物移动速度（像素/帧）
+    constexpr int gameSpeed = 6;        // 开局时地面/障碍物移动速度（像素/帧）
+    constexpr int maxGameSpeed = 13;    // 速度上限（像素/帧）
+    constexpr int speedRampFrames = 600; // 每经过多少帧速度 +1（约 10 秒）
     constexpr int scorePerFrame = 1;    // 记分速度（每帧增加的分数）
 
+    // 固定步长模拟与渲染
+    constexpr int simulationHz = 60;      // 模拟频率（步/秒），与显示刷新率无关
+    constexpr int renderIntervalMs = 4;   // 渲染定时器间隔（毫秒），高刷屏在两步之间插值绘制
+    constexpr int maxCatchUpSteps = 15;   // 卡顿后单次最多追赶的模拟步数，避免越追越慢
+
     // 障碍物生成与缩放
     constexpr int spawnIntervalMin = 70;  // 生成间隔下限（帧）
     constexpr int spawnIntervalMax = 130; // 生成间隔上限（帧）
@@ -38,24 +48,69 @@ namespace GameConfig {
     constexpr int birdSpawnProbability = 30;     // 障碍生成时鸟出现概率（%）
 
     // 恐龙尺寸与碰撞
+    constexpr int dinoX = 50;              // 恐龙左侧 X（固定不动）
+    constexpr int dinoJumpSpeed = -16;     // 起跳初速度（像素/帧）
+    constexpr int dinoGravity = 1;         // 重力加速度（像素/帧²）
+    constexpr int dinoAnimationFrames = 8; // 奔跑/下蹲帧切换间隔（帧）
     constexpr int dinoWidth = 44;          // 恐龙站立状态宽度
     constexpr int dinoHeight = 44;         // 恐龙站立状态高度
     constexpr int dinoDuckHeight = 24;     // 下蹲状态高度
     constexpr int dinoDuckYOffset = 20;    // 下蹲时 Y 轴偏移
     constexpr int collisionInsetX = 4;     // 碰撞矩形水平方向向内收缩像素
     constexpr int collisionInsetY = 4;     // 碰撞矩形竖直方向向内收缩像素
+    constexpr bool pixelPerfectCollision = true; // 粗判命中后是否做像素级掩码判定（false 退化为矩形判定）
+    constexpr int sweepSampleSpacing = 2; // 扫掠粗判命中后，像素级采样之间的最大相对位移（像素）
 
-    // 背景云朵
-    constexpr int cloudCount = 5;          // 同屏云朵数量
-    constexpr int cloudYMin = 40;          // 云朵 Y 最小值
-    constexpr int cloudYMax = 140;         // 云朵 Y 最大值
-    constexpr int cloudSpeedDivisor = 3;   // 云速 = 地速 / cloudSpeedDivisor
+    // 视差背景：每层预先合成一条可回卷的条带，按地面偏移的定点比例滚动（由远到近绘制）
+    enum ParallaxKind {
+        ParallaxHills,   // 远山（按昼夜配色换色）
+        ParallaxClouds,  // 云朵（按昼夜淡化，黑夜隐藏）
+        ParallaxPebbles  // 地面下方的碎石（按昼夜配色换色）
+    };
+    struct ParallaxLayer {
+        ParallaxKind kind;
+        int factorFx; // 滚动比例（16.16 定点，1 << parallaxFixedShift 即与地面同速）
+        int top;      // 条带顶端 Y
+        int span;     // 装饰物顶端 Y 的随机范围（相对 top）
+        int count;    // 每条带的装饰物数量
+    };
+    constexpr int parallaxFixedShift = 16;   // 滚动比例与偏移的定点小数位数
+    constexpr int parallaxStripWidth = 1200; // 条带宽度（即回卷周期，不小于 windowWidth）
+    constexpr int cloudYMin = 40;            // 云朵 Y 最小值
+    constexpr int cloudYMax = 140;           // 云朵 Y 最大值
+    constexpr ParallaxLayer parallaxLayers[] = {
+        {ParallaxHills, (1 << parallaxFixedShift) / 8, groundY - 64, 40, 9},
+        {ParallaxClouds, (1 << parallaxFixedShift) / 3, cloudYMin, cloudYMax - cloudYMin, 8},
+        {ParallaxPebbles, 1 << parallaxFixedShift, groundY + 8, 24, 90},
+    };
+    constexpr int parallaxLayerCount = static_cast<int>(sizeof(parallaxLayers) / sizeof(parallaxLayers[0]));
+
+    // 粒子特效（纯视觉，不参与模拟）
+    constexpr int particleCapacity = 32768;      // 粒子池容量（启动时一次分配，满时丢弃新粒子）
+    constexpr int dustPerStep = 1;               // 奔跑时每个模拟步扬起的尘土数
+    constexpr int landingPuffParticles = 24;     // 落地时扬起的尘土数
+    constexpr int deathDebrisParticles = 160;    // 撞击时飞溅的碎屑数
+    constexpr float particleGravity = 900.0f;    // 碎屑重力加速度（像素/秒²）
+    constexpr float particleFadeSeconds = 0.25f; // 寿命的最后多少秒内淡出
+    constexpr int particleOpacityLevels = 8;     // 淡出量化级数，每级每类一次批量提交
 
     // 时间与场景切换（昼夜）
     constexpr int dayNightCycleFrames = 3000; // 一个完整昼夜周期帧数（约5分钟，60FPS）
     constexpr int dayDurationFrames = 1500;    // 白天持续帧数
     constexpr int nightDurationFrames = 1100;  // 黑夜持续帧数（不含过渡）
     constexpr int transitionFrames = 200;      // 过渡期帧数（昼->夜或夜->昼）
+    constexpr unsigned dayBackgroundRgb = 0xFFFFFF;   // 白天背景色
+    constexpr unsigned nightBackgroundRgb = 0x646478; // 黑夜背景色 RGB(100,100,120)
+    constexpr int nightPaletteLevels = 8; // 贴图昼->夜配色的量化级数（含纯白天与纯黑夜），每级一份图集
+    constexpr int cloudFadeLevels = 8;    // 云朵层预淡化条带数（不含完全隐藏）
+
+    // 神经进化训练（dino_train）
+    constexpr int trainPopulation = 4096;        // 默认种群规模
+    constexpr int trainMaxFrames = 18000;        // 单代最长帧数（约 5 分钟），全部死亡时提前结束本代
+    constexpr double trainEliteFraction = 0.05;  // 原样保留到下一代的精英比例
+    constexpr double trainParentFraction = 0.25; // 可作为父代被变异的前列比例
+    constexpr double trainMutationScale = 0.25;  // 每个权重的最大变异幅度
+    constexpr double ghostOpacity = 0.2;         // 存活个体半透明叠加的不透明度
 }
 
 #endif // GAMECONFIG_H
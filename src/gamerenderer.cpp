@@ -0,0 +1,254 @@
+#include "gamerenderer.h"
+#include "assetloader.h"
+#include "gameconfig.h"
+#include <QPainter>
+#include <QThreadPool>
+#include <utility>
+
+/**
+ * 构造：打包图集、生成各配色级别的图集并计算固定 UI 的位置。
+ * 各配色级别的逐像素换色互不相关，在线程池中并行生成；QPixmap 只能在界面线程创建，最后统一转换。
+ */
+GameRenderer::GameRenderer(const SpriteCache &sprites) {
+    // cache entries first so atlas ids equal sprite handles
+    for (int i = 0; i < sprites.size(); ++i) {
+        atlas.add(sprites.entry(i).image);
+    }
+    trackId = atlas.add(AssetLoader::load(":/other/Track.png"));
+    gameOverId = atlas.add(AssetLoader::load(":/other/GameOver.png"));
+    resetId = atlas.add(AssetLoader::load(":/other/Reset.png"));
+    atlas.build();
+
+    std::vector<QImage> levels(static_cast<size_t>(GameConfig::nightPaletteLevels));
+    levels[0] = atlas.image();
+    QThreadPool pool;
+    for (int level = 1; level < GameConfig::nightPaletteLevels; ++level) {
+        pool.start([this, &levels, level] { levels[static_cast<size_t>(level)] = DayNightCycle::paletteImage(atlas.image(), level); });
+    }
+    pool.waitForDone();
+    for (const QImage &img : levels) {
+        palettes.push_back(QPixmap::fromImage(img));
+    }
+
+    const QRect &resetSrc = atlas.rect(resetId);
+    if (!resetSrc.isEmpty()) {
+        resetRect = QRect((GameConfig::windowWidth - resetSrc.width()) / 2,
+                          GameConfig::windowHeight / 4 + 60,
+                          resetSrc.width(), resetSrc.height());
+    }
+}
+
+/**
+ * 布局：障碍与地面同速移动，插值量取两快照地面偏移之差；恐龙按前后位置插值，
+ * 帧尺寸变化时直接使用当前位置。视差层的偏移由插值后的地面偏移（16.16 定点，保留小数部分）按各层比例换算。
+ */
+void GameRenderer::layout(const WorldSnapshot &previous, const WorldSnapshot &current, qreal alpha, Layout &out) const {
+    const qreal lag = 1.0 - alpha; // 距 current 还差的步数比例
+    out.sky = &cycle.at(current.frameCount);
+
+    // ground and obstacles scroll together
+    int scroll = current.groundOffset - previous.groundOffset;
+    if (scroll < 0) {
+        scroll = 0; // reset between snapshots
+    }
+    const int scrollLag = qRound(scroll * lag);
+    out.groundOffset = current.groundOffset - scrollLag;
+    out.groundMoving = scroll != 0;
+    const qint64 groundFx = (static_cast<qint64>(current.groundOffset) << GameConfig::parallaxFixedShift)
+        - qRound64(scroll * lag * (1 << GameConfig::parallaxFixedShift));
+    for (int i = 0; i < GameConfig::parallaxLayerCount; ++i) {
+        out.parallax[static_cast<size_t>(i)] = ParallaxBackground::offset(i, groundFx);
+    }
+
+    // obstacles (already scaled in the sprite cache), then the dino on top
+    out.sprites.clear();
+    for (const auto& o : current.obstacles) {
+        out.sprites.push_back({atlas.rect(o.sprite), QPoint(o.x + scrollLag, o.y)});
+    }
+    if (current.showDino) {
+        int dinoY = current.dinoRect.y();
+        if (previous.dinoRect.size() == current.dinoRect.size()) {
+            dinoY = qRound(previous.dinoRect.y() * lag + current.dinoRect.y() * alpha);
+        }
+        out.sprites.push_back({atlas.rect(current.dinoSprite), QPoint(current.dinoRect.x(), dinoY)});
+    }
+
+    // training ghosts are deduplicated poses, not tracked agents: draw the current ones as-is
+    out.ghosts.clear();
+    for (const auto& g : current.ghosts) {
+        out.ghosts.push_back({atlas.rect(g.sprite), QPoint(g.x, g.y)});
+    }
+}
+
+/**
+ * 绘制一帧：同一图集上的精灵按绘制阶段收集后批量提交；训练种群的半透明个体
+ * 以片段不透明度与障碍同批提交。
+ * 背景色、配色级别与云朵淡化级别按 current.frameCount 查昼夜表，只选择绘制源，不增加绘制次数。
+ * 视差层由远到近画在背景色之上，每层最多两次贴图。
+ */
+void GameRenderer::render(QPainter &painter, const WorldSnapshot &previous, const WorldSnapshot &current, qreal alpha) {
+    const QRect bounds(0, 0, GameConfig::windowWidth, GameConfig::windowHeight);
+    layout(previous, current, alpha, frame);
+    const DayNightCycle::State &sky = *frame.sky;
+    const QPixmap &atlasPixmap = palettes[static_cast<size_t>(sky.paletteLevel)];
+    hud.setPaletteLevel(sky.paletteLevel);
+
+    // background
+    {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::PhasePaintBackground);
+        // opaque fill: Source skips blending with whatever is underneath
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.fillRect(bounds, QColor::fromRgb(sky.background));
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        for (int i = 0; i < GameConfig::parallaxLayerCount; ++i) {
+            parallax.draw(painter, i, frame.parallax[static_cast<size_t>(i)], sky);
+        }
+    }
+
+    {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::PhasePaintGround);
+        drawGround(painter, frame.groundOffset, sky.paletteLevel);
+        batch.flush(painter, atlasPixmap);
+    }
+
+    {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::PhasePaintSprites);
+        for (const Placement &p : frame.sprites) {
+            batch.add(p.source, p.pos.x(), p.pos.y());
+        }
+        for (const Placement &p : frame.ghosts) {
+            batch.add(p.source, p.pos.x(), p.pos.y(), GameConfig::ghostOpacity);
+        }
+        batch.flush(painter, atlasPixmap);
+    }
+
+    if (particles) {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::PhasePaintParticles);
+        particles->draw(painter, {DayNightCycle::paletteColor(QColor(160, 160, 160), sky.paletteLevel),
+                                  DayNightCycle::paletteColor(QColor(83, 83, 83), sky.paletteLevel)});
+    }
+
+    FrameProfiler::Scope hudScope(profiler, FrameProfiler::PhasePaintHud);
+    hud.drawScore(painter, current.score, current.highScore);
+
+    if (!current.running && !current.gameOver) {
+        // start screen overlay
+        hud.drawStartHint(painter, bounds);
+    }
+
+    if (current.gameOver) {
+        // game over overlay
+        const QRect &gameOverSrc = atlas.rect(gameOverId);
+        batch.add(gameOverSrc, (bounds.width() - gameOverSrc.width()) / 2, bounds.height() / 4);
+        batch.add(atlas.rect(resetId), resetRect.x(), resetRect.y());
+        batch.flush(painter, atlasPixmap);
+    }
+}
+
+namespace {
+
+/**
+ * 比较两组精灵放置：数量相同时只累加发生变化（位置或源矩形）的前后区域，否则累加全部。
+ */
+void addChanged(QRegion &dirty, const std::vector<GameRenderer::Placement> &before,
+                const std::vector<GameRenderer::Placement> &after) {
+    const bool paired = before.size() == after.size();
+    for (size_t i = 0; i < before.size(); ++i) {
+        if (!paired || before[i].source != after[i].source || before[i].pos != after[i].pos) {
+            dirty += QRect(before[i].pos, before[i].source.size());
+            if (paired) {
+                dirty += QRect(after[i].pos, after[i].source.size());
+            }
+        }
+    }
+    for (size_t i = 0; !paired && i < after.size(); ++i) {
+        dirty += QRect(after[i].pos, after[i].source.size());
+    }
+}
+
+} // namespace
+
+/**
+ * 脏区域：逐个比较本次与上次的精灵放置，只累加变化精灵的新旧矩形；
+ * 再加上滚动中的地面带、偏移变化的视差层、数值变化的分数行与出现/消失的覆盖层。静止画面返回空区域。
+ */
+QRegion GameRenderer::dirtyRegion(const WorldSnapshot &previous, const WorldSnapshot &current, qreal alpha) {
+    const QRect bounds(0, 0, GameConfig::windowWidth, GameConfig::windowHeight);
+    layout(previous, current, alpha, probe);
+    const bool startHint = !current.running && !current.gameOver;
+
+    QRegion dirty;
+    const bool skyChanged = !shown.sky || shown.sky->background != probe.sky->background
+        || shown.sky->paletteLevel != probe.sky->paletteLevel;
+    if (fullRepaint || skyChanged) {
+        dirty = bounds;
+    }
+    else {
+        addChanged(dirty, shown.sprites, probe.sprites);
+        addChanged(dirty, shown.ghosts, probe.ghosts);
+        if (particles) {
+            dirty += shownParticles;
+            dirty += particles->bounds();
+        }
+        if (probe.groundMoving || shown.groundOffset != probe.groundOffset) {
+            dirty += groundRect();
+        }
+        for (int i = 0; i < GameConfig::parallaxLayerCount; ++i) {
+            const size_t index = static_cast<size_t>(i);
+            if (shown.parallax[index] != probe.parallax[index]) {
+                dirty += parallax.band(i);
+            }
+        }
+        if (current.score != shownScore || current.highScore != shownHighScore) {
+            dirty += hud.scoreRegion(shownScore, shownHighScore);
+            dirty += hud.scoreRegion(current.score, current.highScore);
+        }
+        if (startHint != shownStartHint) {
+            dirty += hud.startHintRect(bounds);
+        }
+        if (current.gameOver != shownGameOver) {
+            const QRect &gameOverSrc = atlas.rect(gameOverId);
+            dirty += QRect(QPoint((bounds.width() - gameOverSrc.width()) / 2, bounds.height() / 4), gameOverSrc.size());
+            dirty += resetRect;
+        }
+    }
+
+    std::swap(shown, probe); // keep both buffers' capacity
+    shownParticles = particles ? particles->bounds() : QRect();
+    shownScore = current.score;
+    shownHighScore = current.highScore;
+    shownStartHint = startHint;
+    shownGameOver = current.gameOver;
+    fullRepaint = false;
+    return dirty;
+}
+
+QRect GameRenderer::groundRect() const {
+    const QRect &trackSrc = atlas.rect(trackId);
+    const int top = trackSrc.isEmpty() ? GameConfig::groundY
+                                       : GameConfig::groundY - trackSrc.height() + GameConfig::groundAlignOffset;
+    return QRect(0, top, GameConfig::windowWidth, GameConfig::windowHeight - top);
+}
+
+void GameRenderer::drawGround(QPainter &painter, int groundOffset, int paletteLevel) {
+    // draw ground using track texture if valid, fallback to solid blocks
+    int groundY = GameConfig::groundY;
+    const QRect &trackSrc = atlas.rect(trackId);
+    if (!trackSrc.isEmpty()) {
+        int w = trackSrc.width();
+        int h = trackSrc.height();
+        int xStart = -(groundOffset % w);
+        for (int x = xStart; x < GameConfig::windowWidth; x += w) {
+            batch.add(trackSrc, x, groundY - h + GameConfig::groundAlignOffset); // slight raise to align
+        }
+    }
+    else {
+        painter.setBrush(DayNightCycle::paletteColor(QColor(83, 83, 83), paletteLevel));
+        painter.setPen(Qt::NoPen);
+        int tileW = 40;
+        int xStart = -(groundOffset % tileW);
+        for (int x = xStart; x < GameConfig::windowWidth; x += tileW) {
+            painter.drawRect(x, groundY, tileW, GameConfig::windowHeight - groundY);
+        }
+    }
+}
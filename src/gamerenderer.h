@@ -0,0 +1,138 @@
+#ifndef GAMERENDERER_H
+#define GAMERENDERER_H
+
+#include <QPixmap>
+#include <QRect>
+#include <QRegion>
+#include <array>
+#include <vector>
+#include "daynightcycle.h"
+#include "frameprofiler.h"
+#include "hudrenderer.h"
+#include "parallaxbackground.h"
+#include "particlesystem.h"
+#include "spriteatlas.h"
+#include "spritecache.h"
+#include "worldsnapshot.h"
+
+class QPainter;
+
+/**
+ * 游戏渲染器：把世界快照绘制到任意 QPainter（窗口或离屏图片）。
+ * 所有贴图在构造时打包进一张图集，精灵通过 SpriteBatch 批量提交。
+ * 支持在前后两个固定步长快照之间插值，使高刷新率显示也能平滑滚动。
+ * 每个绘制阶段（背景、地面、精灵、HUD）结束时各提交一次批次，便于分阶段计时。
+ * 昼夜效果全部查表：每个配色级别一张预生成的图集，视差背景各层使用预换色/预淡化的条带，
+ * 过渡期的绘制开销与白天相同。
+ */
+class GameRenderer {
+public:
+    /**
+     * 构造并打包图集：先按句柄顺序放入贴图缓存的全部条目，再放入地面与 UI 贴图，
+     * 然后为每个昼夜配色级别生成一份图集；视差背景的条带同时合成。
+     * @param sprites 世界使用的预缩放贴图缓存（图集编号与其句柄一致）。
+     */
+    explicit GameRenderer(const SpriteCache &sprites);
+
+    /**
+     * 绘制一帧（背景、视差层、地面、障碍、恐龙、分数与覆盖层）。
+     * 位置在 previous 与 current 之间按 alpha 线性插值。
+     * @param painter 目标画家。
+     * @param previous 上一个模拟步的快照。
+     * @param current 最新模拟步的快照。
+     * @param alpha 插值系数 0-1（0 为 previous，1 为 current）。
+     */
+    void render(QPainter &painter, const WorldSnapshot &previous, const WorldSnapshot &current, qreal alpha);
+
+    /**
+     * 不插值，直接绘制单个快照。
+     * @param painter 目标画家。
+     * @param snapshot 要绘制的快照。
+     */
+    void render(QPainter &painter, const WorldSnapshot &snapshot) { render(painter, snapshot, snapshot, 1.0); }
+
+    /**
+     * 设置分析器，render() 的各绘制阶段耗时会记录到其中；传 nullptr 关闭。
+     * @param value 分析器（不转移所有权）。
+     */
+    void setProfiler(FrameProfiler *value) { profiler = value; }
+
+    /**
+     * 设置要绘制的粒子池（画在障碍与恐龙之上）；传 nullptr 不绘制粒子。
+     * 粒子由调用方推进，脏区域包含其上次与本次的包围盒。
+     * @param value 粒子池（不转移所有权）。
+     */
+    void setParticles(ParticleSystem *value) { particles = value; }
+
+    /**
+     * 脏区域：按给定快照绘制时与上一次调用相比可能改变的像素区域，
+     * 即上次与本次各精灵覆盖范围的并集、滚动中的地面带与视差层、数值变化的分数行与覆盖层；
+     * 背景色或配色级别变化时返回整个窗口。调用后记住本次的覆盖范围。
+     * @param previous 上一个模拟步的快照。
+     * @param current 最新模拟步的快照。
+     * @param alpha 插值系数 0-1。
+     */
+    QRegion dirtyRegion(const WorldSnapshot &previous, const WorldSnapshot &current, qreal alpha);
+
+    /** 让下一次 dirtyRegion() 返回整个窗口（重开、叠加层切换等）。 */
+    void invalidate() { fullRepaint = true; }
+
+    /** 重开按钮的屏幕区域（仅游戏结束时显示）。 */
+    [[nodiscard]] QRect resetButtonRect() const { return resetRect; }
+
+    /** 一个精灵的绘制位置。 */
+    struct Placement {
+        QRect source; // 图集源矩形
+        QPoint pos;   // 屏幕左上角
+    };
+private:
+    /** 一帧内所有精灵的插值后位置，render() 与 dirtyRegion() 共用。 */
+    struct Layout {
+        const DayNightCycle::State *sky = nullptr; // 本帧昼夜状态
+        std::vector<Placement> sprites;            // 障碍与恐龙（按绘制顺序）
+        std::vector<Placement> ghosts;             // 训练种群的半透明个体（画在最上层）
+        int groundOffset = 0;                      // 插值后的地面偏移
+        std::array<int, GameConfig::parallaxLayerCount> parallax{}; // 各视差层的条带偏移
+        bool groundMoving = false;                 // 地面是否在两快照间滚动
+    };
+
+    /**
+     * 计算插值后的布局（复用 out 的容量）。
+     */
+    void layout(const WorldSnapshot &previous, const WorldSnapshot &current, qreal alpha, Layout &out) const;
+
+    /** 地面带在屏幕上的区域。 */
+    [[nodiscard]] QRect groundRect() const;
+
+    /**
+     * 绘制滚动地面；贴图缺失时退化为纯色方块。
+     * @param painter 目标画家。
+     * @param groundOffset 地面滚动偏移。
+     * @param paletteLevel 昼夜配色级别（纯色方块同样换色）。
+     */
+    void drawGround(QPainter &painter, int groundOffset, int paletteLevel);
+
+    SpriteAtlas atlas;     // 全部贴图的图集
+    std::vector<QPixmap> palettes; // 各昼夜配色级别的图集像素图（绘制源），0 为白天原色
+    DayNightCycle cycle;   // 昼夜查找表
+    SpriteBatch batch;     // 批量提交层
+    HudRenderer hud;       // 分数与提示文字缓存
+    ParallaxBackground parallax; // 视差背景条带
+    SpriteAtlas::Id trackId;
+    SpriteAtlas::Id gameOverId;
+    SpriteAtlas::Id resetId;
+    QRect resetRect;       // 重开按钮绘制区域
+    Layout frame;          // render() 使用的布局
+    Layout probe;          // dirtyRegion() 本次计算的布局
+    Layout shown;          // 上次 dirtyRegion() 的布局（即屏幕上应有的内容）
+    QRect shownParticles;  // 上次 dirtyRegion() 时的粒子包围盒
+    int shownScore = -1;   // 上次 dirtyRegion() 时的分数
+    int shownHighScore = -1;
+    bool shownStartHint = false;
+    bool shownGameOver = false;
+    bool fullRepaint = true; // 下一次是否整窗重绘
+    FrameProfiler *profiler = nullptr; // 可选的阶段耗时分析器
+    ParticleSystem *particles = nullptr; // 可选的粒子池
+};
+
+#endif // GAMERENDERER_H
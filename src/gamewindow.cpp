@@ -2,168 +2,114 @@
 #include "gameconfig.h"
 #include <QPainter>
 #include <QKeyEvent>
-#include <QFont>
-#include <QFontMetrics>
-#include <QRandomGenerator>
 #include <QMouseEvent>
-#include <QString>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
 #include <algorithm>
+#include <utility>
+
+namespace {
+constexpr qint64 stepNs = 1000000000LL / GameConfig::simulationHz; // 固定模拟步长（纳秒）
+}
 
 /**
- * 构造：设置窗口、计时器并初始化游戏状态。
+ * 构造：设置窗口、计时器；模拟线程在初始化列表中启动，渲染器随后打包图集。
  */
-GameWindow::GameWindow(QWidget* parent) : QWidget(parent) {
+GameWindow::GameWindow(QWidget* parent) : QWidget(parent), simulation(&profiler), renderer(simulation.getSprites()) {
     setFixedSize(GameConfig::windowWidth, GameConfig::windowHeight);
-    dino = new Dino(this);
     timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, &GameWindow::gameLoop);
-    timer->start(16); // ~60 FPS
+    timer->setTimerType(Qt::PreciseTimer);
+    connect(timer, &QTimer::timeout, this, &GameWindow::gameLoop); // started by wake() once the game starts
     setFocusPolicy(Qt::StrongFocus);
+    setAttribute(Qt::WA_OpaquePaintEvent); // every pixel comes from the backbuffer
 
-    // assets
-    trackImg = QPixmap(":/other/Track.png");
-    gameOverImg = QPixmap(":/other/GameOver.png");
-    resetImg = QPixmap(":/other/Reset.png");
-    cloudImg = QPixmap(":/other/Cloud.png");
-    smallCactusImgs = {
-        QPixmap(":/cactus/SmallCactus1.png"),
-        QPixmap(":/cactus/SmallCactus2.png"),
-        QPixmap(":/cactus/SmallCactus3.png")
-    };
-    largeCactusImgs = {
-        QPixmap(":/cactus/LargeCactus1.png"),
-        QPixmap(":/cactus/LargeCactus2.png"),
-        QPixmap(":/cactus/LargeCactus3.png")
-    };
-
-    // init game state
-    speed = GameConfig::gameSpeed; // constant speed
-    spawnIntervalMin = GameConfig::spawnIntervalMin; // frames
-    spawnIntervalMax = GameConfig::spawnIntervalMax;
-    score = 0;
-    highScore = 0;
+    showProfiler = false;
+    renderer.setProfiler(&profiler);
+    renderer.setParticles(&particles);
 
-    // init clouds positions
-    clouds.clear();
-    for (int i = 0; i < GameConfig::cloudCount; ++i) {
-        Cloud c;
-        c.x = QRandomGenerator::global()->bounded(GameConfig::windowWidth);
-        c.y = QRandomGenerator::global()->bounded(GameConfig::cloudYMin, GameConfig::cloudYMax + 1);
-        clouds.push_back(c);
+    dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dataDir);
+    loadHighScore();
+    if (!history.open(QDir(dataDir).filePath(GameConfig::HISTORY_FILE))) {
+        qWarning("Failed to open run history in %s", qPrintable(dataDir));
     }
 
     resetGame();
 }
 
 /**
- * 析构：释放动态分配的恐龙对象。
+ * 析构：子对象由 Qt 父子关系释放。
  */
-GameWindow::~GameWindow() {
-    delete dino;
-}
+GameWindow::~GameWindow() = default;
 
 /**
- * 负责绘制背景、地面、恐龙以及开始提示。
+ * 负责绘制：渲染器只把待更新区域画进常驻后备缓冲，再把本次事件要求的区域原样拷到窗口。
+ * 后备缓冲与所有贴图同为 ARGB32_Premultiplied，拷贝走光栅引擎的 SIMD 快速路径；
+ * 仅因遮挡/曝光触发的重绘不必重新渲染。
  */
-void GameWindow::paintEvent(QPaintEvent*) {
-    QPainter painter(this);
-
-    // background
-    painter.fillRect(rect(), QColor(255, 255, 255));
-
-    // draw clouds (slow parallax scroll)
-    if (!cloudImg.isNull()) {
-        for (const auto& c : clouds) {
-            painter.drawPixmap(c.x, c.y, cloudImg);
-        }
+void GameWindow::paintEvent(QPaintEvent* event) {
+    const qreal dpr = devicePixelRatioF();
+    const QSize pixelSize = size() * dpr;
+    if (backbuffer.size() != pixelSize) {
+        backbuffer = QImage(pixelSize, QImage::Format_ARGB32_Premultiplied);
+        backbuffer.setDevicePixelRatio(dpr);
+        pendingRegion = rect();
     }
 
-    // draw ground using track texture if valid, fallback to solid blocks
-    int groundY = GameConfig::groundY;
-    if (!trackImg.isNull()) {
-        int w = trackImg.width();
-        int h = trackImg.height();
-        int xStart = -(groundOffset % w);
-        for (int x = xStart; x < width(); x += w) {
-            painter.drawPixmap(x, groundY - h + GameConfig::groundAlignOffset, trackImg); // slight raise to align
+    const bool rendered = !pendingRegion.isEmpty();
+    if (rendered) {
+        QPainter back(&backbuffer);
+        back.setClipRegion(pendingRegion);
+        {
+            FrameProfiler::Scope scope(&profiler, FrameProfiler::PhasePaint);
+            const SimFrame &frame = simulation.frame();
+            renderer.render(back, frame.previous, frame.current, interpolation);
         }
-    }
-    else {
-        painter.setBrush(QColor(83, 83, 83));
-        painter.setPen(Qt::NoPen);
-        int tileW = 40;
-        int xStart = -(groundOffset % tileW);
-        for (int x = xStart; x < width(); x += tileW) {
-            painter.drawRect(x, groundY, tileW, height() - groundY);
+        if (showProfiler) {
+            profiler.drawOverlay(back, rect());
         }
+        pendingRegion = QRegion();
     }
 
-    // draw cacti
-    for (const auto& c : cacti) {
-        painter.drawPixmap(c.x, c.y, c.w, c.h, c.pix);
+    QPainter painter(this);
+    painter.setCompositionMode(QPainter::CompositionMode_Source); // backbuffer is opaque
+    for (const QRect &r : event->region()) {
+        painter.drawImage(QRectF(r), backbuffer, QRectF(r.x() * dpr, r.y() * dpr, r.width() * dpr, r.height() * dpr));
     }
 
-    // draw dino
-    dino->draw(&painter);
-
-    // draw score and high score on the top-right
-    QFont scoreFont = painter.font();
-    scoreFont.setPointSize(14);
-    painter.setFont(scoreFont);
-    QFontMetrics fm(scoreFont);
-    QString scoreText = QString("%1").arg(score, 5, 10, QChar('0'));
-    QString hiText = QString("HI %1").arg(highScore, 5, 10, QChar('0'));
-    int margin = 16;
-    int yText = margin + fm.ascent();
-    int scoreWidth = fm.horizontalAdvance(scoreText);
-    int hiWidth = fm.horizontalAdvance(hiText);
-    int xScore = width() - margin - scoreWidth;
-    int xHi = xScore - margin - hiWidth;
-    painter.drawText(xHi, yText, hiText);
-    painter.drawText(xScore, yText, scoreText);
-
-    if (!isRunning && !isGameOver) {
-        // start screen overlay
-        painter.setPen(Qt::black);
-        QFont f = painter.font();
-        f.setPointSize(18);
-        painter.setFont(f);
-        painter.drawText(rect(), Qt::AlignCenter, "Press SPACE to Start");
+    if (launchClock.isValid()) {
+        const qint64 startupNs = launchClock.nsecsElapsed();
+        profiler.record(FrameProfiler::PhaseStartup, startupNs);
+        qInfo("startup: %.1f ms (launch to first painted frame)", startupNs / 1e6);
+        launchClock.invalidate();
     }
 
-    if (isGameOver) {
-        // game over overlay
-        if (!gameOverImg.isNull()) {
-            int x = (width() - gameOverImg.width()) / 2;
-            int y = height() / 4;
-            painter.drawPixmap(x, y, gameOverImg);
-        }
-        if (!resetImg.isNull()) {
-            int x = (width() - resetImg.width()) / 2;
-            int y = height() / 4 + 60;
-            painter.drawPixmap(x, y, resetImg);
-            resetRect = QRect(x, y, resetImg.width(), resetImg.height());
-        }
-        else {
-            resetRect = QRect();
-        }
-    }
-    else {
-        resetRect = QRect();
+    // input-to-present: first frame that contains the step the input was applied to
+    if (rendered && latencyStartNs >= 0) {
+        profiler.record(FrameProfiler::PhaseInputLatency, simulation.elapsedNs() - latencyStartNs);
+        latencyStartNs = -1;
     }
 }
 
 /**
- * 处理按键按下：空格用于开始/跳跃，下键用于下蹲。
+ * 处理按键按下：空格用于开始/跳跃，下键用于下蹲，F3 切换分析叠加层。
+ * 自动重复的按键事件一律忽略；游戏中的跳跃与下蹲带事件时间戳交给模拟线程，
+ * 落到其发生时刻所属的模拟步上。状态取自最近显示的一帧。
  */
 void GameWindow::keyPressEvent(QKeyEvent* event) {
+    if (event->isAutoRepeat()) {
+        return; // held keys must not re-fire
+    }
+    const WorldSnapshot &state = simulation.frame().current;
     if (event->key() == Qt::Key_Space) {
-        if (!isRunning && !isGameOver) {
-            isRunning = true; // start the game
-            dino->setGameStarted(true);
+        if (!state.running && !state.gameOver) {
+            commandSerial = simulation.start(); // start the game
+            wake();
         }
-        else if (!isGameOver) {
-            dino->jump();
+        else if (!state.gameOver) {
+            simulation.push(event->timestamp(), InputQueue::KindJump);
         }
         else {
             // restart
@@ -171,131 +117,248 @@ void GameWindow::keyPressEvent(QKeyEvent* event) {
         }
     }
     else if (event->key() == Qt::Key_Down) {
-        if (!isGameOver) {
-            dino->setDucking(true);
+        if (!state.gameOver) {
+            simulation.push(event->timestamp(), InputQueue::KindDuckPress);
         }
     }
+    else if (event->key() == Qt::Key_F3) {
+        showProfiler = !showProfiler;
+        renderer.invalidate();
+        pendingRegion = rect();
+        update();
+        wake();
+    }
 }
 
 /**
- * 处理按键释放：松开下键停止下蹲。
+ * 处理按键释放：松开下键停止下蹲（自动重复产生的释放事件忽略）。
  */
 void GameWindow::keyReleaseEvent(QKeyEvent* event) {
+    if (event->isAutoRepeat()) {
+        return;
+    }
     if (event->key() == Qt::Key_Down) {
-        dino->setDucking(false);
+        simulation.push(event->timestamp(), InputQueue::KindDuckRelease);
     }
 }
 
 /**
- * 游戏循环：更新世界状态并请求重绘。
+ * 渲染循环：世界由模拟线程推进，这里只取最新发布的一帧。
+ * 插值系数 = 距 current 所在步结束已过去的时间 / 步长，与固定步长累加器的余量一致；
+ * 模拟线程略晚于步末执行时系数封顶为 1，画面停在 current 而不是外推。
+ * 只重绘脏区域；游戏未在运行、且已提交的命令都已生效时画完最后一帧即停表。
  */
 void GameWindow::gameLoop() {
-    if (isRunning && !isGameOver) {
-        groundOffset += speed;
-        score += GameConfig::scorePerFrame;
-        dino->update();
-        updateCacti();
-        // move clouds slower for parallax
-        for (auto& c : clouds) {
-            c.x -= speed / GameConfig::cloudSpeedDivisor;
-        }
-        // wrap clouds
-        for (auto& c : clouds) {
-            if (c.x + cloudImg.width() < 0) {
-                c.x = width();
-                c.y = QRandomGenerator::global()->bounded(GameConfig::cloudYMin, GameConfig::cloudYMax + 1);
-            }
-        }
-        if (checkCollision()) {
-            isGameOver = true;
-            isRunning = false;
-            dino->setDead(true);
-            highScore = std::max(highScore, score);
-        }
+    const qint64 now = simulation.elapsedNs();
+    const qint64 elapsedNs = now - lastTickNs;
+    profiler.record(FrameProfiler::PhaseFrame, elapsedNs);
+    lastTickNs = now;
+    if (simulation.acquire()) {
+        onFrame(simulation.frame());
+    }
+    if (!particles.empty()) {
+        FrameProfiler::Scope scope(&profiler, FrameProfiler::PhaseParticleUpdate);
+        particles.update(static_cast<float>(std::min(elapsedNs, stepNs * GameConfig::maxCatchUpSteps)) / 1e9f);
+    }
+    const SimFrame &frame = simulation.frame();
+    interpolation = std::clamp(static_cast<qreal>(now - frame.stepEndNs) / stepNs, qreal(0), qreal(1));
+    requestRepaint();
+
+    // nothing moves on the start screen or after game over: stop ticking until input arrives
+    if (!frame.current.running && !showProfiler && particles.empty() && frame.serial == commandSerial) {
+        timer->stop();
     }
-    update();
 }
 
-void GameWindow::resetGame() {
-    isRunning = false;
-    isGameOver = false;
-    groundOffset = 0;
-    score = 0;
-    cacti.clear();
-    spawnCooldown = spawnIntervalMin;
-    dino->reset();
+/**
+ * 新帧：界面可能跳过若干帧，按输入总数找出其中最早一个尚未计入的输入作为延迟起点；
+ * 本局结束且此前的命令都已生效（不是重开前的旧帧）时保存一次跑局。
+ */
+void GameWindow::onFrame(const SimFrame &frame) {
+    if (frame.inputCount != shownInputs) {
+        const quint32 missed = frame.inputCount - shownInputs;
+        const quint32 first = missed > SimFrame::recentInputs ? frame.inputCount - SimFrame::recentInputs : shownInputs;
+        if (latencyStartNs < 0) {
+            latencyStartNs = frame.inputNs[first % SimFrame::recentInputs];
+        }
+        shownInputs = frame.inputCount;
+    }
+    emitParticles(frame);
+    if (frame.current.gameOver && !runSaved && frame.serial == commandSerial) {
+        runSaved = true;
+        saveRun(frame);
+    }
 }
 
-void GameWindow::spawnCactus() {
-    bool useLarge = QRandomGenerator::global()->bounded(2) == 0;
-    const auto& list = useLarge ? largeCactusImgs : smallCactusImgs;
-    if (list.empty()) return;
-    int idx = QRandomGenerator::global()->bounded(static_cast<int>(list.size()));
-    QPixmap pix = list[idx];
-    if (pix.isNull()) return;
+/**
+ * 按渲染器给出的脏区域请求重绘；叠加层打开时整窗重绘（曲线每帧变化）。
+ */
+void GameWindow::requestRepaint() {
+    if (showProfiler) {
+        renderer.invalidate();
+    }
+    const SimFrame &frame = simulation.frame();
+    const QRegion dirty = renderer.dirtyRegion(frame.previous, frame.current, interpolation);
+    if (!dirty.isEmpty()) {
+        pendingRegion += dirty;
+        update(dirty);
+    }
+}
 
-    // random scale range
-    double scaleMin = useLarge ? GameConfig::cactusScaleLargeMin : GameConfig::cactusScaleSmallMin;
-    double scaleMax = useLarge ? GameConfig::cactusScaleLargeMax : GameConfig::cactusScaleSmallMax;
-    double scale = randomScale(scaleMin, scaleMax);
-    // special cap for LargeCactus3 to reduce width/height
-    if (useLarge && idx == 2) {
-        scale = std::min(scale, GameConfig::cactusScaleLarge3Cap);
+/**
+ * 唤醒渲染循环（模拟线程自己计时，不受定时器启停影响）。
+ */
+void GameWindow::wake() {
+    if (!timer->isActive()) {
+        lastTickNs = simulation.elapsedNs();
+        timer->start(GameConfig::renderIntervalMs);
     }
+}
 
-    pix = pix.scaled(static_cast<int>(pix.width() * scale), static_cast<int>(pix.height() * scale), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+void GameWindow::setSeed(quint32 value) {
+    fixedSeed = true;
+    seed = value;
+    resetGame();
+}
 
-    Cactus c;
-    c.pix = pix;
-    c.w = pix.width();
-    c.h = pix.height();
-    c.x = width();
-    int groundY = GameConfig::groundY;
-    c.y = groundY - c.h + GameConfig::groundAlignOffset; // align bottom with track
-    cacti.push_back(c);
+void GameWindow::setCoursePath(const QString &path) {
+    simulation.setCoursePath(path);
+    resetGame();
 }
 
-void GameWindow::updateCacti() {
-    // spawn timer
-    spawnCooldown -= 1;
-    if (spawnCooldown <= 0) {
-        spawnCactus();
-        int interval = QRandomGenerator::global()->bounded(GameConfig::spawnIntervalMin, GameConfig::spawnIntervalMax + 1);
-        spawnCooldown = interval;
+/**
+ * 重开：命令交给模拟线程，渲染循环保持运行直到取到重置后的那一帧。
+ */
+void GameWindow::resetGame() {
+    commandSerial = simulation.reset(fixedSeed, seed);
+    latencyStartNs = -1;
+    runSaved = false;
+    particles.clear();
+    renderer.invalidate();
+    pendingRegion = rect();
+    update();
+    wake();
+}
+
+/**
+ * 界面可能跳过若干步，扬尘按推进的步数补齐；落地与撞击按帧上记录的事件各发射一次。
+ * 水平速度取自地面滚动，尘土随地面向后飘。
+ */
+void GameWindow::emitParticles(const SimFrame &frame) {
+    const WorldSnapshot &state = frame.current;
+    const QRect &dino = state.dinoRect;
+    const int steps = std::clamp(state.frameCount - particleFrame, 0, GameConfig::maxCatchUpSteps);
+    const qreal groundSpeed = (state.groundOffset - frame.previous.groundOffset) * GameConfig::simulationHz; // px/s
+    particleFrame = state.frameCount;
+
+    if (state.running && !state.dinoAirborne && steps > 0) {
+        ParticleSystem::Emitter dust;
+        dust.origin = QPointF(dino.left() + 8, GameConfig::groundY - 5);
+        dust.spread = QPointF(4, 2);
+        dust.velocity = QPointF(-groundSpeed * 0.5, -30);
+        dust.velocityJitter = QPointF(20, 15);
+        dust.life = 0.4f;
+        dust.lifeJitter = 0.15f;
+        dust.gravity = 40.0f;
+        particles.spawn(dust, GameConfig::dustPerStep * steps);
     }
+    if (state.landFrame >= 0 && state.landFrame != particleLandFrame) {
+        ParticleSystem::Emitter puff;
+        puff.origin = QPointF(dino.center().x(), GameConfig::groundY - 5);
+        puff.spread = QPointF(dino.width() / 2.0, 1);
+        puff.velocity = QPointF(-groundSpeed * 0.3, -40);
+        puff.velocityJitter = QPointF(80, 25);
+        puff.life = 0.35f;
+        puff.lifeJitter = 0.1f;
+        puff.gravity = 60.0f;
+        particles.spawn(puff, GameConfig::landingPuffParticles);
+    }
+    particleLandFrame = state.landFrame;
+    if (state.gameOver && !particleGameOver) {
+        ParticleSystem::Emitter debris;
+        debris.origin = QPointF(dino.right() - 8, dino.center().y());
+        debris.spread = QPointF(6, dino.height() / 3.0);
+        debris.velocity = QPointF(-60, -220);
+        debris.velocityJitter = QPointF(220, 140);
+        debris.life = 1.2f;
+        debris.lifeJitter = 0.4f;
+        debris.gravity = GameConfig::particleGravity;
+        debris.kind = ParticleSystem::KindDebris;
+        particles.spawn(debris, GameConfig::deathDebrisParticles);
+    }
+    particleGameOver = state.gameOver;
+}
 
-    // move cacti
-    for (auto& c : cacti) {
-        c.x -= speed;
+void GameWindow::saveRun(const SimFrame &frame) {
+    RunHistory::Entry entry;
+    entry.score = static_cast<quint32>(frame.current.score);
+    entry.frames = static_cast<quint32>(frame.current.frameCount);
+    entry.seed = frame.seed;
+    entry.cause = frame.deathCause;
+    // appending may grow and remap the file: keep it off the GUI thread
+    writer.post([this, entry] { history.append(entry); });
+    if (frame.current.highScore > savedHighScore) {
+        saveHighScore(frame.current.highScore);
     }
+}
 
-    // remove off-screen
-    cacti.erase(std::remove_if(cacti.begin(), cacti.end(), [&](const Cactus& c) {
-        return c.x + c.w < 0;
-        }), cacti.end());
+/**
+ * 启动时读取加密的高分文件；文件不存在或内容无法解密时从 0 开始。
+ */
+void GameWindow::loadHighScore() {
+    QFile file(QDir(dataDir).filePath(GameConfig::HIGHSCORE_FILE));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return; // first launch
+    }
+    const int score = decryptScore(QString::fromLatin1(file.readAll().trimmed()));
+    if (score > 0) {
+        savedHighScore = score;
+        commandSerial = simulation.setHighScore(score);
+    }
 }
 
-bool GameWindow::checkCollision() const {
-    QRect dinoRect = dino->boundingRect();
-    for (const auto& c : cacti) {
-        QRect cactusRect(c.x, c.y, c.w, c.h);
-        if (dinoRect.intersects(cactusRect)) {
-            return true;
-        }
+/**
+ * 把加密后的高分交给后台写入线程（QSaveFile 写临时文件后原子重命名），立即返回。
+ */
+void GameWindow::saveHighScore(int score) {
+    savedHighScore = score;
+    writer.write(QDir(dataDir).filePath(GameConfig::HIGHSCORE_FILE), encryptScore(savedHighScore).toLatin1());
+}
+
+/**
+ * 以密钥的 SHA-256 作为密钥流与分数的十进制文本逐字节异或，输出十六进制字符串。
+ */
+QString GameWindow::encryptScore(int score) {
+    const QByteArray keyHash = QCryptographicHash::hash(GameConfig::ENCRYPTION_KEY.toUtf8(), QCryptographicHash::Sha256);
+    const QByteArray scoreData = QByteArray::number(score);
+    QByteArray encrypted;
+    encrypted.reserve(scoreData.size());
+    for (qsizetype i = 0; i < scoreData.size(); ++i) {
+        encrypted.append(static_cast<char>(scoreData[i] ^ keyHash[i % keyHash.size()]));
     }
-    return false;
+    return QString::fromLatin1(encrypted.toHex());
+}
+
+/**
+ * encryptScore() 的逆过程；内容被篡改或不是合法数字时返回 -1。
+ */
+int GameWindow::decryptScore(const QString &encrypted) {
+    const QByteArray keyHash = QCryptographicHash::hash(GameConfig::ENCRYPTION_KEY.toUtf8(), QCryptographicHash::Sha256);
+    const QByteArray encryptedData = QByteArray::fromHex(encrypted.toLatin1());
+    QByteArray decrypted;
+    decrypted.reserve(encryptedData.size());
+    for (qsizetype i = 0; i < encryptedData.size(); ++i) {
+        decrypted.append(static_cast<char>(encryptedData[i] ^ keyHash[i % keyHash.size()]));
+    }
+    bool ok = false;
+    const int score = decrypted.toInt(&ok);
+    return ok ? score : -1;
 }
 
 void GameWindow::mousePressEvent(QMouseEvent* event) {
-    if (isGameOver && resetRect.isValid() && resetRect.contains(event->pos())) {
+    const QRect resetRect = renderer.resetButtonRect();
+    if (simulation.frame().current.gameOver && resetRect.isValid() && resetRect.contains(event->pos())) {
         resetGame();
     }
     QWidget::mousePressEvent(event);
 }
-
-double GameWindow::randomScale(double min, double max) const {
-    if (min >= max) return min;
-    // use uniform double
-    double t = QRandomGenerator::global()->generateDouble();
-    return min + (max - min) * t;
-}
@@ -3,10 +3,15 @@
 
 #include <QWidget>
 #include <QTimer>
-#include <QPixmap>
-#include <vector>
-#include "dino.h"
+#include <QElapsedTimer>
+#include <QImage>
+#include <QRegion>
+#include "backgroundwriter.h"
+#include "gamerenderer.h"
 #include "gameconfig.h"
+#include "particlesystem.h"
+#include "runhistory.h"
+#include "simulationthread.h"
 
 class QMouseEvent;
 
@@ -23,15 +28,42 @@ public:
      * 析构函数，释放内部资源。
      */
     ~GameWindow() override;
+
+    /** 帧分析器（用于退出时导出 CSV）。 */
+    [[nodiscard]] const FrameProfiler &getProfiler() const { return profiler; }
+
+    /**
+     * 固定随机种子：之后每一局都用同一种子开始（用于复现）。
+     * @param value 随机种子。
+     */
+    void setSeed(quint32 value);
+
+    /**
+     * 设置录制输出路径：每局结束时把种子与输入序列写入该文件（覆盖上一局）。
+     * @param path 文件路径，为空时不录制到磁盘。
+     */
+    void setRecordPath(const QString &path) { simulation.setRecordPath(path); }
+
+    /**
+     * 设置障碍赛道文件：之后每一局都按赛道生成障碍（手工关卡或导出的“每日种子”）。
+     * @param path 文件路径，为空时恢复随机生成。
+     */
+    void setCoursePath(const QString &path);
+
+    /**
+     * 设置启动计时器（在 main() 开头启动）：第一帧绘制完成时记录启动耗时。
+     * @param clock 已启动的计时器。
+     */
+    void setLaunchClock(const QElapsedTimer &clock) { launchClock = clock; }
 protected:
     /**
-     * 绘制窗口内容（背景、地面、云朵、障碍、恐龙、UI）。
+     * 绘制窗口内容（背景、视差层、地面、障碍、恐龙、UI）。
      * @param event Qt 绘制事件（未使用）。
      */
     void paintEvent(QPaintEvent *event) override;
 
     /**
-     * 处理按键按下（开始/跳跃、下蹲）。
+     * 处理按键按下（开始/跳跃、下蹲、F3 切换分析叠加层）。
      * @param event 键盘事件。
      */
     void keyPressEvent(QKeyEvent *event) override;
@@ -49,107 +81,61 @@ protected:
     void mousePressEvent(QMouseEvent *event) override;
 private slots:
     /**
-     * 游戏主循环：每帧更新世界状态并请求重绘。
+     * 渲染循环：取模拟线程发布的最新帧，按时钟计算插值系数并请求重绘。
      */
     void gameLoop();
 private:
-    struct Cactus {
-        QPixmap pix; // 仙人掌贴图
-        int x;       // 左上角 X
-        int y;       // 左上角 Y
-        int w;       // 宽度
-        int h;       // 高度
-    };
-
-    struct Bird {
-        QPixmap pix; // 鸟当前帧贴图
-        int x;
-        int y;
-        int w;
-        int h;
-        int animationFrame;   // 当前动画帧索引（0/1）
-        int animationCounter; // 动画计数器
-    };
-
-    struct Cloud {
-        int x;
-        int y;
-    };
-
     /** 重置游戏到初始状态。 */
     void resetGame();
-    /** 障碍生成入口：按分数与概率生成仙人掌或鸟。 */
-    void spawnObstacle();
-    /** 生成仙人掌障碍。 */
-    void spawnCactus();
-    /** 生成鸟类障碍。 */
-    void spawnBird();
-    /** 更新仙人掌位置、生成、清理。 */
-    void updateCacti();
-    /** 更新鸟类位置、动画、清理。 */
-    void updateBirds();
+    /** 只对渲染器报告的脏区域请求重绘。 */
+    void requestRepaint();
+    /** 空闲停表后重新启动主循环（开始游戏、打开叠加层时）。 */
+    void wake();
+    /** 新取到一帧后：记录输入延迟起点、发射粒子，本局结束时保存跑局。 */
+    void onFrame(const SimFrame &frame);
+    /** 按新帧上的奔跑、落地与撞击发射粒子。 */
+    void emitParticles(const SimFrame &frame);
     /**
-     * 碰撞检测：矩形粗判 + 像素级 alpha 判定。
-     * @return true 表示碰撞发生。
+     * 本局结束：追加跑局历史，破纪录时异步保存最高分。
+     * @param frame 本局最后一帧。
      */
-    bool checkCollision() const;
+    void saveRun(const SimFrame &frame);
+    /** 加载最高分（本地加密存储，启动时同步读取一次）。 */
+    void loadHighScore();
     /**
-     * 返回 [min,max] 区间内的随机双精度数。
-     * @param min 下限。
-     * @param max 上限。
+     * 保存最高分（本地加密存储，交给后台写入线程，不阻塞界面）。
+     * @param score 新的最高分。
      */
-    double randomScale(double min, double max) const;
-    /** 加载最高分（本地加密存储）。 */
-    void loadHighScore();
-    /** 保存最高分（本地加密存储）。 */
-    void saveHighScore();
+    void saveHighScore(int score);
     /** AES/XOR 简化加密分数。 */
     QString encryptScore(int score);
     /** AES/XOR 简化解密分数。 */
     int decryptScore(const QString &encrypted);
-    /** 更新昼夜周期状态与背景颜色。 */
-    void updateDayNightCycle();
-    /** 颜色线性插值。 */
-    QColor interpolateColor(const QColor &from, const QColor &to, float alpha) const;
-    /** 获取云朵透明度（受昼夜过渡影响）。 */
-    float getCloudAlpha() const;
-
-    QTimer *timer; // 帧定时器
-    Dino *dino;   // 玩家对象
-
-    // game state
-    bool isRunning;      // 游戏是否在运行（开始后为 true）
-    bool isGameOver;     // 游戏是否结束
-    int groundOffset;    // 地面滚动偏移
-    int speed;           // 游戏速度（像素/帧）
-    int score;           // 当前分数
-    int highScore;       // 历史最高分
-
-    // time and day-night cycle
-    int gameFrameCount;      // 总游戏帧数计数
-    bool isNight;            // 当前是否黑夜
-    int cyclePosition;       // 昼夜周期位置
-    float dayNightTransitionAlpha; // 昼夜过渡进度 0-1
-    QColor currentBackgroundColor; // 当前背景颜色
-
-    // obstacles
-    std::vector<Cactus> cacti;
-    std::vector<Bird> birds;
-    std::vector<Cloud> clouds;
-    int spawnCooldown;   // 帧计数器，<=0 时生成
-    int spawnIntervalMin;
-    int spawnIntervalMax;
-
-    // assets
-    QPixmap trackImg;
-    QPixmap gameOverImg;
-    QPixmap resetImg;
-    QPixmap cloudImg;
-    std::vector<QPixmap> smallCactusImgs;
-    std::vector<QPixmap> largeCactusImgs;
-    std::vector<QPixmap> birdImgs; // 鸟类两帧动画
 
-    QRect resetRect; // 重开按钮绘制区域
+    FrameProfiler profiler; // 各阶段耗时（需在 simulation/renderer 之前构造）
+    bool showProfiler;      // 是否显示分析叠加层（F3 切换）
+    QTimer *timer; // 渲染定时器（比模拟步更密，用于插值；空闲时停止）
+    qint64 lastTickNs = 0; // 上次 gameLoop 的时钟读数（纳秒）
+    SimulationThread simulation; // 模拟线程（持有世界，需在 profiler 之后构造）
+    GameRenderer renderer; // 图集 + 批量绘制渲染器（需在 simulation 之后构造）
+    quint32 commandSerial = 0;   // 最后提交给模拟线程的命令序号
+    quint32 shownInputs = 0;     // 已计入延迟统计的带输入步数
+    qint64 latencyStartNs = -1;  // 已进入模拟、尚未显示的最早输入时刻（-1 表示没有）
+    bool runSaved = false;       // 本局是否已写入跑局历史
+    ParticleSystem particles;    // 扬尘、落地与撞击粒子（界面线程推进）
+    int particleFrame = 0;       // 已发射过扬尘的帧号
+    int particleLandFrame = -1;  // 已发射过尘土的落地帧号
+    bool particleGameOver = false; // 是否已发射过撞击碎屑
+    qreal interpolation = 1.0;   // 渲染插值系数 0-1
+    QImage backbuffer;      // 常驻后备缓冲（ARGB32_Premultiplied，物理像素尺寸）
+    QRegion pendingRegion;  // 后备缓冲中待重新渲染的区域
+    bool fixedSeed = false; // 是否每局使用固定种子
+    quint32 seed = 0;       // 固定种子
+    QElapsedTimer launchClock; // 自 main() 开头起计时，第一帧后作废
+    QString dataDir;        // 本地存储目录（AppDataLocation）
+    int savedHighScore = 0; // 已提交保存的最高分
+    RunHistory history;     // 跑局历史（内存映射，打开后只在写入线程访问）
+    BackgroundWriter writer; // 高分文件的后台原子写入与历史追加（须在 history 之后声明，先于它析构）
 };
 
 #endif // GAMEWINDOW_H
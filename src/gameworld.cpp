@@ -0,0 +1,323 @@
+#include "gameworld.h"
+#include "gameconfig.h"
+#include "jumptable.h"
+#include "sweptaabb.h"
+#include <QRandomGenerator>
+#include <QString>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+/** 线性插值一个整数坐标。 */
+QPoint lerp(const QPoint &from, const QPoint &to, double t) {
+    return QPoint(from.x() + qRound((to.x() - from.x()) * t), from.y() + qRound((to.y() - from.y()) * t));
+}
+
+} // namespace
+
+/**
+ * 构造：准备预缩放贴图缓存并初始化世界状态。
+ */
+GameWorld::GameWorld(std::shared_ptr<const SpriteCache> sharedSprites)
+    : sprites(sharedSprites ? std::move(sharedSprites) : std::make_shared<const SpriteCache>()) {
+    // init game state
+    speed = GameConfig::gameSpeed; // ramps up in step()
+    spawnIntervalMin = GameConfig::spawnIntervalMin; // frames
+    spawnIntervalMax = GameConfig::spawnIntervalMax;
+    score = 0;
+    highScore = 0;
+
+    reset();
+}
+
+void GameWorld::reset() {
+    reset(QRandomGenerator::global()->generate());
+}
+
+/**
+ * 以指定种子重置：重新播种 rng，保证整局可复现。
+ */
+void GameWorld::reset(quint32 value) {
+    seed = value;
+    rng.seed(seed);
+    isRunning = false;
+    isGameOver = false;
+    groundOffset = 0;
+    score = 0;
+    frameCount = 0;
+    speed = GameConfig::gameSpeed;
+    deathCause = DeathNone;
+    landFrame = -1;
+    obstacles.clear();
+    courseNext = 0;
+    droppedSpawns = 0;
+    shiftedSpawns = 0;
+    spawnCooldown = spawnIntervalMin;
+    dino.reset();
+    Dino::Frame frame;
+    prevDinoRect = dino.boundingRect();
+    dino.currentFrame(frame, prevDinoDrawRect);
+}
+
+void GameWorld::start() {
+    if (!isRunning && !isGameOver) {
+        isRunning = true;
+        dino.setGameStarted(true);
+    }
+}
+
+/**
+ * 推进一帧：按帧数提升速度，应用输入后依次更新恐龙、障碍，最后做碰撞检测。
+ * 速度只随帧数变化，同一种子与输入序列仍然得到同一局。
+ */
+void GameWorld::step(const InputState &input) {
+    if (!isRunning || isGameOver) {
+        return;
+    }
+    FrameProfiler::Scope stepScope(profiler, FrameProfiler::PhaseStep);
+
+    speed = speedAt(frameCount);
+    Dino::Frame prevFrame;
+    prevDinoRect = dino.boundingRect();
+    dino.currentFrame(prevFrame, prevDinoDrawRect);
+
+    if (input.jump) {
+        dino.jump();
+    }
+    dino.setDucking(input.duck);
+
+    groundOffset += speed;
+    score += GameConfig::scorePerFrame;
+    ++frameCount;
+    {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::PhaseDinoUpdate);
+        dino.update();
+    }
+    if (dino.justLanded()) {
+        landFrame = frameCount;
+    }
+    {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::PhaseObstacleUpdate);
+        updateObstacles();
+    }
+    bool hit = false;
+    SpriteCache::Handle hitSprite = 0;
+    if (dinoCollision) {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::PhaseCollision);
+        hit = checkCollision(&hitSprite);
+    }
+    if (hit) {
+        deathCause = sprites->isBird(hitSprite) ? DeathBird : DeathCactus;
+        isGameOver = true;
+        isRunning = false;
+        dino.setDead(true);
+        highScore = std::max(highScore, score);
+    }
+}
+
+bool GameWorld::loadCourse(const QString &path) {
+    course.close();
+    courseNext = 0;
+    return path.isEmpty() || course.open(path);
+}
+
+int GameWorld::speedAt(int frame) {
+    return std::min(GameConfig::maxGameSpeed, GameConfig::gameSpeed + frame / GameConfig::speedRampFrames);
+}
+
+void GameWorld::snapshot(WorldSnapshot &out) const {
+    out.running = isRunning;
+    out.gameOver = isGameOver;
+    out.frameCount = frameCount;
+    out.groundOffset = groundOffset;
+    out.score = score;
+    out.highScore = highScore;
+    out.showDino = dinoCollision;
+    Dino::Frame frame;
+    dino.currentFrame(frame, out.dinoRect);
+    out.dinoSprite = sprites->dino(frame);
+    out.dinoAirborne = dino.airborne();
+    out.landFrame = landFrame;
+    out.obstacles.clear();
+    for (int i = 0; i < obstacles.size(); ++i) {
+        out.obstacles.push_back({sprites->animated(obstacles.sprite(i), frameCount), obstacles.x(i), obstacles.y(i)});
+    }
+    out.ghosts.clear(); // filled by Population::ghosts() in training mode
+}
+
+/**
+ * 障碍生成入口：分数达到阈值后按概率生成鸟，否则生成仙人掌。
+ */
+void GameWorld::spawnObstacle() {
+    if (score >= GameConfig::birdSpawnScoreThreshold && rng.bounded(100) < GameConfig::birdSpawnProbability) {
+        spawnBird();
+    }
+    else {
+        spawnCactus();
+    }
+}
+
+/**
+ * 生成仙人掌：随机种类与缩放档位。
+ */
+void GameWorld::spawnCactus() {
+    ObstacleCourse::Entry entry;
+    entry.type = ObstacleCourse::TypeCactus;
+    bool useLarge = rng.bounded(2) == 0;
+    int kinds = useLarge ? SpriteCache::largeCactusKinds : SpriteCache::smallCactusKinds;
+    int idx = rng.bounded(kinds);
+    entry.variant = static_cast<quint8>(useLarge ? SpriteCache::smallCactusKinds + idx : idx);
+    entry.bucket = static_cast<quint8>(rng.bounded(SpriteCache::scaleBuckets));
+    spawn(entry);
+}
+
+/**
+ * 生成鸟：随机档位与飞行高度，高度表示鸟中心距地面的距离。
+ */
+void GameWorld::spawnBird() {
+    ObstacleCourse::Entry entry;
+    entry.type = ObstacleCourse::TypeBird;
+    entry.bucket = static_cast<quint8>(rng.bounded(SpriteCache::scaleBuckets));
+    entry.height = static_cast<quint8>(rng.bounded(2) == 0 ? GameConfig::birdHeightLow : GameConfig::birdHeightHigh);
+    spawn(entry);
+}
+
+/**
+ * 直接引用缓存中的预缩放贴图，O(1)。仙人掌底边与赛道对齐；鸟只保存第 0 帧句柄
+ * （动画由全局帧时钟决定），两帧尺寸不同，包围盒取第 0 帧（较大）的尺寸，各帧共用同一左上角。
+ */
+void GameWorld::spawn(const ObstacleCourse::Entry &entry) {
+    if (courseWriter) {
+        ObstacleCourse::Entry recorded = entry;
+        recorded.frame = static_cast<quint32>(frameCount);
+        courseWriter->append(recorded);
+    }
+    if (entry.bucket >= SpriteCache::scaleBuckets) return;
+    SpriteCache::Handle handle;
+    if (entry.type == ObstacleCourse::TypeCactus && entry.variant < SpriteCache::cactusKinds) {
+        handle = sprites->cactus(entry.variant, entry.bucket);
+    }
+    else if (entry.type == ObstacleCourse::TypeBird) {
+        handle = sprites->bird(0, entry.bucket);
+    }
+    else {
+        return;
+    }
+    const QImage &img = sprites->entry(handle).image;
+    if (img.isNull()) return;
+
+    int y;
+    if (entry.type == ObstacleCourse::TypeBird) {
+        int groundBase = GameConfig::groundY + GameConfig::groundAlignOffset;
+        y = groundBase - entry.height - img.height() / 2;
+    }
+    else {
+        y = GameConfig::groundY - img.height() + GameConfig::groundAlignOffset; // align bottom with track
+    }
+    const int x = spawnX(y, img.width(), img.height());
+    if (x < 0) {
+        ++droppedSpawns;
+        return;
+    }
+    if (x > GameConfig::windowWidth) {
+        ++shiftedSpawns;
+    }
+    obstacles.push(handle, x, y, img.width(), img.height());
+}
+
+/**
+ * 只与队尾（上一个生成的）障碍比较：表中的间距条件保证逐对满足即整个序列可越过。
+ * 间距按当前速度换算成像素；两障碍同速移动，其间的速度提升每 speedRampFrames 帧只有 1，忽略不计。
+ * 随机生成的每种障碍都能越过、spawnIntervalMin 不小于所需间距，由 jumptable.h 的 static_assert 保证，
+ * 因此随机序列与位置不会因此改变；赛道记录可能被跳过或推迟，分别计入 droppedSpawns/shiftedSpawns。
+ */
+int GameWorld::spawnX(int y, int width, int height) const {
+    const JumpTable::Hurdle next = JumpTable::hurdle(y, width, height);
+    if (!JumpTable::clearable(speed, next)) {
+        return -1;
+    }
+    int x = GameConfig::windowWidth;
+    if (!obstacles.empty()) {
+        const int last = obstacles.size() - 1;
+        const JumpTable::Hurdle prev = JumpTable::hurdle(obstacles.y(last), obstacles.width(last), obstacles.height(last));
+        x = std::max(x, obstacles.x(last) + JumpTable::spacingFrames(speed, prev, next) * speed);
+    }
+    return x;
+}
+
+/**
+ * 更新障碍：载入赛道时生成所有已到生成帧的记录，否则按冷却计时随机生成；然后统一移动与退役。
+ */
+void GameWorld::updateObstacles() {
+    if (course.isOpen()) {
+        // authored course: records are sorted by frame, read through the sliding window
+        ObstacleCourse::Entry entry;
+        while (course.at(courseNext, entry) && entry.frame <= static_cast<quint32>(frameCount)) {
+            spawn(entry);
+            ++courseNext;
+        }
+    }
+    else {
+        // spawn timer
+        spawnCooldown -= 1;
+        if (spawnCooldown <= 0) {
+            spawnObstacle();
+            int interval = rng.bounded(spawnIntervalMin, spawnIntervalMax + 1);
+            spawnCooldown = interval;
+        }
+    }
+
+    // move obstacles, then retire from the head (leftmost first)
+    obstacles.advance(speed);
+    obstacles.retireOffscreen();
+}
+
+/**
+ * 碰撞检测：障碍按生成顺序即按 x 递增排列，跳过已在恐龙左侧的，
+ * 遇到第一个左边界越过恐龙右侧的即可结束，仙人掌与鸟共用同一遍扫描。
+ * 粗判是连续的：恐龙矩形从步初扫到步末，障碍从步初（x + speed）扫到当前位置，
+ * 只有扫掠区间相交的障碍才进入像素级判定，高速下窄障碍不会在两帧之间穿过恐龙。
+ * 像素级判定在相交区间内按 sweepSampleSpacing 采样，用预建掩码（双方都取本步末的帧，
+ * 鸟取当前动画帧）逐个位置比较；任一方掩码缺失（贴图加载失败）时退化为矩形判定。
+ */
+bool GameWorld::checkCollision(SpriteCache::Handle *hitSprite) const {
+    const QRect dinoRect = dino.boundingRect();
+    const int dinoRight = std::max(dinoRect.right(), prevDinoRect.right());
+    Dino::Frame frame;
+    QRect dinoDrawRect;
+    dino.currentFrame(frame, dinoDrawRect);
+    const CollisionMask &dinoMask = sprites->entry(sprites->dino(frame)).mask;
+    for (int i = 0; i < obstacles.size(); ++i) {
+        if (obstacles.x(i) > dinoRight) {
+            break; // sorted by x, and obstacles only move left: nothing after can have reached the dino
+        }
+        const QRect obstacleRect = obstacles.rect(i);
+        double enter = 0.0;
+        double exit = 0.0;
+        if (!SweptAabb::overlapInterval(prevDinoRect, dinoRect, obstacleRect.translated(speed, 0), obstacleRect, enter, exit)) {
+            continue;
+        }
+        const CollisionMask &obstacleMask = sprites->entry(sprites->animated(obstacles.sprite(i), frameCount)).mask;
+        bool hit = !GameConfig::pixelPerfectCollision || dinoMask.isNull() || obstacleMask.isNull();
+        if (!hit) {
+            // relative travel inside the overlap window decides how many poses to test
+            const double travel = (exit - enter) * std::max(speed, std::abs(dinoDrawRect.y() - prevDinoDrawRect.y()));
+            const int samples = static_cast<int>(std::ceil(travel / GameConfig::sweepSampleSpacing));
+            for (int k = 0; k <= samples && !hit; ++k) {
+                const double t = samples == 0 ? exit : enter + (exit - enter) * k / samples;
+                const QPoint dinoPos = lerp(prevDinoDrawRect.topLeft(), dinoDrawRect.topLeft(), t);
+                const QPoint obstaclePos(obstacleRect.x() + qRound(speed * (1.0 - t)), obstacleRect.y());
+                hit = CollisionMask::overlaps(dinoMask, dinoPos, obstacleMask, obstaclePos);
+            }
+        }
+        if (hit) {
+            if (hitSprite) {
+                *hitSprite = obstacles.sprite(i);
+            }
+            return true;
+        }
+    }
+    return false;
+}
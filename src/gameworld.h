@@ -0,0 +1,192 @@
+#ifndef GAMEWORLD_H
+#define GAMEWORLD_H
+
+#include <QRandomGenerator>
+#include <memory>
+#include <vector>
+#include "dino.h"
+#include "frameprofiler.h"
+#include "obstaclecourse.h"
+#include "obstaclestore.h"
+#include "spritecache.h"
+#include "worldsnapshot.h"
+
+/**
+ * 单帧输入状态，由窗口、回放或脚本产生后交给 GameWorld::step()。
+ */
+struct InputState {
+    bool jump = false; // 本帧触发跳跃
+    bool duck = false; // 下蹲键是否按住
+};
+
+/**
+ * 无界面的游戏世界：持有恐龙物理、障碍物、分数等全部状态，
+ * 每次 step() 推进一帧。不依赖 QWidget/QTimer，可供窗口渲染或无头仿真使用。
+ */
+class GameWorld {
+public:
+    /** 本局死因（写入跑局历史）。 */
+    enum DeathCause : quint8 {
+        DeathNone = 0, // 未死亡
+        DeathCactus,   // 撞上仙人掌
+        DeathBird      // 撞上鸟
+    };
+
+    /**
+     * 构造世界。
+     * @param sharedSprites 共享的预缩放贴图缓存；为空时自行构建一份。
+     */
+    explicit GameWorld(std::shared_ptr<const SpriteCache> sharedSprites = nullptr);
+
+    /** 以新的随机种子重置到初始状态（等待开始）。 */
+    void reset();
+
+    /**
+     * 以指定种子重置：同一种子加同一输入序列必然得到同一局（用于录制回放）。
+     * @param value 随机种子。
+     */
+    void reset(quint32 value);
+
+    /** 开始游戏（仅在等待开始状态下生效）。 */
+    void start();
+
+    /**
+     * 推进一帧：应用输入、更新恐龙/障碍并检测碰撞。
+     * 未运行或已结束时不做任何事。
+     * @param input 本帧输入。
+     */
+    void step(const InputState &input);
+
+    /**
+     * 把渲染所需状态写入快照（复用快照内已有容量）。
+     * @param out 输出快照。
+     */
+    void snapshot(WorldSnapshot &out) const;
+
+    [[nodiscard]] bool running() const { return isRunning; }
+    [[nodiscard]] bool gameOver() const { return isGameOver; }
+    [[nodiscard]] int getScore() const { return score; }
+    [[nodiscard]] int getHighScore() const { return highScore; }
+    [[nodiscard]] int getGroundOffset() const { return groundOffset; }
+    [[nodiscard]] int getSpeed() const { return speed; }
+    [[nodiscard]] int getFrameCount() const { return frameCount; }
+    [[nodiscard]] quint32 getSeed() const { return seed; }
+    [[nodiscard]] DeathCause getDeathCause() const { return deathCause; }
+    [[nodiscard]] const Dino &getDino() const { return dino; }
+    [[nodiscard]] const SpriteCache &getSprites() const { return *sprites; }
+    [[nodiscard]] const ObstacleStore &getObstacles() const { return obstacles; }
+
+    /**
+     * 某帧的地面速度：从 gameSpeed 开始，每 speedRampFrames 帧加 1，封顶 maxGameSpeed。
+     * @param frame 本局帧数（step() 开始时的 frameCount）。
+     */
+    static int speedAt(int frame);
+
+    /**
+     * 设置分析器，step() 内各阶段耗时会记录到其中；传 nullptr 关闭。
+     * @param value 分析器（不转移所有权）。
+     */
+    void setProfiler(FrameProfiler *value) { profiler = value; }
+
+    /**
+     * 设置历史最高分（例如从本地存储读取后）。
+     * @param value 最高分。
+     */
+    void setHighScore(int value) { highScore = value; }
+
+    /**
+     * 载入障碍赛道：此后每局按文件中的记录生成障碍（不再随机生成），赛道结束后不再有障碍。
+     * 记录经滑动映射窗口按需读取，载入不随赛道长度变慢。
+     * @param path 赛道文件；为空时卸载赛道，恢复随机生成。
+     * @return 文件无法打开或格式不对时返回 false（此时仍为随机生成）。
+     */
+    bool loadCourse(const QString &path);
+
+    /** 是否按载入的赛道生成障碍。 */
+    [[nodiscard]] bool hasCourse() const { return course.isOpen(); }
+
+    /**
+     * 本局因越不过而跳过的生成次数。随机生成由 JumpTable 的编译期检查保证为 0，
+     * 非 0 说明赛道中有不公平的记录（或替换了贴图）。
+     */
+    [[nodiscard]] int getDroppedSpawns() const { return droppedSpawns; }
+
+    /** 本局因与上一个障碍太近而被推到右侧的生成次数（随机生成同样恒为 0）。 */
+    [[nodiscard]] int getShiftedSpawns() const { return shiftedSpawns; }
+
+    /**
+     * 设置赛道录制：之后每次生成（随机或来自赛道）都追加一条记录，用于导出“每日种子”赛道。
+     * @param value 写入器（不转移所有权），传 nullptr 停止录制。
+     */
+    void setCourseWriter(ObstacleCourseWriter *value) { courseWriter = value; }
+
+    /**
+     * 是否检测自身恐龙的碰撞。训练模式关闭它，世界只作为障碍流一直推进，
+     * 种群个体各自判定碰撞（见 Population）。障碍的随机序列不受影响。
+     * @param enabled false 表示自身恐龙永不死亡。
+     */
+    void setDinoCollision(bool enabled) { dinoCollision = enabled; }
+private:
+    friend struct GameWorldBench; // dino_bench 直接计时私有阶段
+
+    /** 障碍生成入口：按分数与概率生成仙人掌或鸟。 */
+    void spawnObstacle();
+    /** 随机选择仙人掌种类与档位并生成。 */
+    void spawnCactus();
+    /** 随机选择鸟的档位与飞行高度并生成。 */
+    void spawnBird();
+    /**
+     * 按一条记录生成障碍（随机生成与赛道共用）：取预缩放贴图、对齐地面并放到公平位置。
+     * 记录越界（未知类型、种类或档位）时忽略。
+     */
+    void spawn(const ObstacleCourse::Entry &entry);
+    /**
+     * 公平生成位置：查跳跃可达性表（O(1)），越不过的障碍不生成；
+     * 与上一个障碍的间距不够连续越过时，把新障碍向右推到刚好够的位置。
+     * @return 生成位置 X，-1 表示不生成。
+     */
+    int spawnX(int y, int width, int height) const;
+    /** 更新障碍（仙人掌与鸟）位置、生成、退役。 */
+    void updateObstacles();
+    /**
+     * 碰撞检测：按 x 有序的扫掠包围盒粗判（越过恐龙即提前结束）+ 步内采样的像素级 alpha 判定。
+     * @param hitSprite 可选输出：撞上的障碍句柄。
+     * @return true 表示碰撞发生。
+     */
+    bool checkCollision(SpriteCache::Handle *hitSprite = nullptr) const;
+
+    Dino dino; // 玩家物理状态
+    QRect prevDinoRect;     // 本步开始时恐龙的碰撞矩形（扫掠粗判起点）
+    QRect prevDinoDrawRect; // 本步开始时恐龙的绘制矩形（像素级采样起点）
+    FrameProfiler *profiler = nullptr; // 可选的阶段耗时分析器
+    bool dinoCollision = true;         // 是否检测自身恐龙碰撞（训练模式关闭）
+
+    // game state
+    bool isRunning;      // 游戏是否在运行（开始后为 true）
+    bool isGameOver;     // 游戏是否结束
+    int groundOffset;    // 地面滚动偏移
+    int speed;           // 游戏速度（像素/帧），随帧数提升
+    int score;           // 当前分数
+    int highScore;       // 历史最高分
+    int frameCount;      // 本局游戏帧数
+    quint32 seed = 0;    // 本局随机种子
+    DeathCause deathCause = DeathNone; // 本局死因
+    int landFrame = -1;  // 最近一次落地的帧号
+    QRandomGenerator rng; // 本局全部随机决策的唯一来源（不使用全局生成器）
+
+    // obstacles
+    ObstacleStore obstacles; // 仙人掌与鸟（SoA 环形缓冲区，按 x 递增）
+    ObstacleCourse course;   // 载入的障碍赛道（未打开时随机生成）
+    int courseNext = 0;      // 下一条待生成的赛道记录
+    int droppedSpawns = 0;   // 本局跳过的生成次数
+    int shiftedSpawns = 0;   // 本局推迟的生成次数
+    ObstacleCourseWriter *courseWriter = nullptr; // 可选的赛道录制
+    int spawnCooldown;   // 帧计数器，<=0 时生成
+    int spawnIntervalMin;
+    int spawnIntervalMax;
+
+    // sprites
+    std::shared_ptr<const SpriteCache> sprites; // 预缩放贴图与掩码
+};
+
+#endif // GAMEWORLD_H
@@ -0,0 +1,153 @@
+#include "hudrenderer.h"
+#include "daynightcycle.h"
+#include "gameconfig.h"
+#include <QFont>
+#include <QFontMetrics>
+#include <QImage>
+#include <QPainter>
+#include <QString>
+#include <algorithm>
+
+namespace {
+
+/**
+ * 把一段文字渲染成透明底贴图，基线位于 ascent 处。
+ * @param font 字体。
+ * @param text 文字。
+ * @param color 文字颜色。
+ */
+QPixmap renderText(const QFont &font, const QString &text, const QColor &color) {
+    QFontMetrics fm(font);
+    QImage img(std::max(1, fm.horizontalAdvance(text)), fm.height(), QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::transparent);
+    QPainter painter(&img);
+    painter.setFont(font);
+    painter.setPen(color);
+    painter.drawText(0, fm.ascent(), text);
+    painter.end();
+    return QPixmap::fromImage(img);
+}
+
+} // namespace
+
+/**
+ * 构造：分数字体 14pt、提示字体 18pt，与原先逐帧绘制的样式一致；
+ * 白天为黑色，其余配色级别逐级向白色过渡。
+ */
+HudRenderer::HudRenderer() : palettes(static_cast<size_t>(GameConfig::nightPaletteLevels)) {
+    QFont scoreFont;
+    scoreFont.setPointSize(14);
+    QFont hintFont;
+    hintFont.setPointSize(18);
+    for (int level = 0; level < GameConfig::nightPaletteLevels; ++level) {
+        const QColor color = DayNightCycle::paletteColor(Qt::black, level);
+        Glyphs &g = palettes[static_cast<size_t>(level)];
+        for (int d = 0; d < 10; ++d) {
+            g.digits[d] = renderText(scoreFont, QString::number(d), color);
+        }
+        g.hiLabel = renderText(scoreFont, QStringLiteral("HI "), color);
+        g.startHint = renderText(hintFont, QStringLiteral("Press SPACE to Start"), color);
+    }
+    lineHeight = QFontMetrics(scoreFont).height();
+}
+
+/**
+ * 切换配色：级别变化时作废已拼接的两行，下一次 drawScore() 用新字形重拼。
+ */
+void HudRenderer::setPaletteLevel(int level) {
+    level = std::clamp(level, 0, GameConfig::nightPaletteLevels - 1);
+    if (level == paletteLevel) {
+        return;
+    }
+    paletteLevel = level;
+    scoreLine.value = -1;
+    hiLine.value = -1;
+}
+
+void HudRenderer::drawScore(QPainter &painter, int score, int highScore) {
+    updateLine(scoreLine, score, QPixmap());
+    updateLine(hiLine, highScore, palettes[static_cast<size_t>(paletteLevel)].hiLabel);
+    int xScore = GameConfig::windowWidth - margin - scoreLine.pixmap.width();
+    int xHi = xScore - margin - hiLine.pixmap.width();
+    painter.drawPixmap(xHi, margin, hiLine.pixmap);
+    painter.drawPixmap(xScore, margin, scoreLine.pixmap);
+}
+
+void HudRenderer::drawStartHint(QPainter &painter, const QRect &bounds) {
+    painter.drawPixmap(startHintRect(bounds).topLeft(), palettes[static_cast<size_t>(paletteLevel)].startHint);
+}
+
+/**
+ * 与 drawScore() 相同的排版，但只计算宽度，不拼接贴图。
+ */
+QRegion HudRenderer::scoreRegion(int score, int highScore) const {
+    const int scoreWidth = lineWidth(score, QPixmap());
+    const int hiWidth = lineWidth(highScore, palettes[static_cast<size_t>(paletteLevel)].hiLabel);
+    const int xScore = GameConfig::windowWidth - margin - scoreWidth;
+    const int xHi = xScore - margin - hiWidth;
+    return QRegion(xHi, margin, hiWidth, lineHeight) + QRegion(xScore, margin, scoreWidth, lineHeight);
+}
+
+QRect HudRenderer::startHintRect(const QRect &bounds) const {
+    const QPixmap &startHint = palettes[static_cast<size_t>(paletteLevel)].startHint;
+    return QRect(bounds.x() + (bounds.width() - startHint.width()) / 2,
+                 bounds.y() + (bounds.height() - startHint.height()) / 2,
+                 startHint.width(), startHint.height());
+}
+
+int HudRenderer::splitDigits(int value, int *out) {
+    int count = 0;
+    unsigned v = static_cast<unsigned>(std::max(value, 0));
+    do {
+        out[count++] = static_cast<int>(v % 10);
+        v /= 10;
+    } while (v != 0);
+    while (count < minDigits) {
+        out[count++] = 0;
+    }
+    return count;
+}
+
+int HudRenderer::lineWidth(int value, const QPixmap &prefix) const {
+    const Glyphs &glyphs = palettes[static_cast<size_t>(paletteLevel)];
+    int digitValues[12];
+    const int count = splitDigits(value, digitValues);
+    int width = prefix.width();
+    for (int i = 0; i < count; ++i) {
+        width += glyphs.digits[digitValues[i]].width();
+    }
+    return width;
+}
+
+/**
+ * 拼接一行：数值未变时直接复用；宽度不变时复用原像素图，只重画内容。
+ */
+void HudRenderer::updateLine(Line &line, int value, const QPixmap &prefix) {
+    if (line.value == value && !line.pixmap.isNull()) {
+        return;
+    }
+    line.value = value;
+    const Glyphs &glyphs = palettes[static_cast<size_t>(paletteLevel)];
+
+    // decimal digits, least significant first, zero padded
+    int digitValues[12];
+    const int count = splitDigits(value, digitValues);
+
+    const int width = lineWidth(value, prefix);
+    if (line.pixmap.width() != width || line.pixmap.height() != lineHeight) {
+        line.pixmap = QPixmap(width, lineHeight);
+    }
+    line.pixmap.fill(Qt::transparent);
+
+    QPainter painter(&line.pixmap);
+    int x = 0;
+    if (!prefix.isNull()) {
+        painter.drawPixmap(x, 0, prefix);
+        x += prefix.width();
+    }
+    for (int i = count - 1; i >= 0; --i) {
+        const QPixmap &glyph = glyphs.digits[digitValues[i]];
+        painter.drawPixmap(x, 0, glyph);
+        x += glyph.width();
+    }
+}
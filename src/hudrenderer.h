@@ -0,0 +1,100 @@
+#ifndef HUDRENDERER_H
+#define HUDRENDERER_H
+
+#include <QPixmap>
+#include <QRect>
+#include <QRegion>
+#include <vector>
+
+class QPainter;
+
+/**
+ * 分数与提示文字的缓存绘制层：启动时把数字 0-9、"HI" 与提示文字各渲染一次，
+ * 分数行由缓存的数字贴图拼成，且只在数值变化时重新拼接，
+ * 每帧不再创建 QFont/QFontMetrics、格式化字符串或测量文字宽度。
+ * 每个昼夜配色级别各有一套字形，切换级别只会触发一次重新拼接。
+ */
+class HudRenderer {
+public:
+    /** 构造并预渲染全部字形（需在 QGuiApplication 之后构造）。 */
+    HudRenderer();
+
+    /**
+     * 在右上角绘制 "HI 最高分" 与当前分数（不足 5 位补零）。
+     * @param painter 目标画家。
+     * @param score 当前分数。
+     * @param highScore 最高分。
+     */
+    void drawScore(QPainter &painter, int score, int highScore);
+
+    /**
+     * 在区域中央绘制开始提示。
+     * @param painter 目标画家。
+     * @param bounds 居中参考区域。
+     */
+    void drawStartHint(QPainter &painter, const QRect &bounds);
+
+    /**
+     * drawScore() 会覆盖的区域（两行分数的矩形），用于局部重绘。
+     * @param score 当前分数。
+     * @param highScore 最高分。
+     */
+    [[nodiscard]] QRegion scoreRegion(int score, int highScore) const;
+
+    /**
+     * drawStartHint() 会覆盖的矩形。
+     * @param bounds 居中参考区域。
+     */
+    [[nodiscard]] QRect startHintRect(const QRect &bounds) const;
+
+    /**
+     * 切换昼夜配色级别（见 DayNightCycle）。
+     * @param level 配色级别 [0, nightPaletteLevels)。
+     */
+    void setPaletteLevel(int level);
+private:
+    struct Glyphs {
+        QPixmap digits[10]; // 数字字形
+        QPixmap hiLabel;    // "HI " 前缀
+        QPixmap startHint;  // 开始提示文字
+    };
+
+    struct Line {
+        int value = -1; // 已拼接的数值，-1 表示尚未拼接
+        QPixmap pixmap; // 拼接结果
+    };
+
+    /**
+     * 把数值拆成十进制位（低位在前，不足 minDigits 补零）。
+     * @param value 数值。
+     * @param out 输出数组（至少 12 项）。
+     * @return 位数。
+     */
+    static int splitDigits(int value, int *out);
+
+    /**
+     * 一行拼接后的宽度。
+     * @param value 数值。
+     * @param prefix 行首前缀贴图（可为空）。
+     */
+    [[nodiscard]] int lineWidth(int value, const QPixmap &prefix) const;
+
+    /**
+     * 数值变化时用缓存字形重新拼接一行。
+     * @param line 目标行缓存。
+     * @param value 新数值。
+     * @param prefix 行首前缀贴图（可为空）。
+     */
+    void updateLine(Line &line, int value, const QPixmap &prefix);
+
+    static constexpr int margin = 16;    // 距窗口边缘与两行之间的间距
+    static constexpr int minDigits = 5;  // 补零位数
+
+    std::vector<Glyphs> palettes; // 每个配色级别一套字形
+    int paletteLevel = 0;         // 当前配色级别
+    int lineHeight = 0; // 分数行高度（字体行高）
+    Line scoreLine;
+    Line hiLine;
+};
+
+#endif // HUDRENDERER_H
@@ -0,0 +1,174 @@
+#include "inputlog.h"
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+namespace {
+
+constexpr char magic[4] = {'D', 'I', 'N', 'O'};
+// 改变同一种子与输入下模拟结果的改动都要递增版本，旧日志在 load() 时直接拒绝
+// 2: 达到分数阈值后生成鸟，鸟的概率与档位/高度抽取改变了随机数序列
+// 3: 速度随帧数递增（GameWorld::speedAt）
+// 4: 去掉云朵的随机数抽取（改为视差条带），每个种子的障碍序列都变了
+// 5: 文件头后记录障碍赛道路径
+constexpr quint8 version = 5;
+
+void putVarint(QByteArray &out, quint32 value) {
+    while (value >= 0x80) {
+        out.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+/**
+ * 读取 varint，越界或超过 5 字节时返回 false。
+ */
+bool getVarint(const QByteArray &in, qsizetype &pos, quint32 &value) {
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (pos >= in.size()) {
+            return false;
+        }
+        const auto byte = static_cast<quint8>(in[pos++]);
+        value |= static_cast<quint32>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+void InputLog::begin(quint32 value) {
+    seed = value;
+    course.clear();
+    entries.clear();
+    finished = false;
+    finalFrame = 0;
+    finalScore = 0;
+    recordedDuck = false;
+    rewind();
+}
+
+void InputLog::record(quint32 frame, const InputState &input) {
+    if (input.jump) {
+        append(frame, EventJump);
+    }
+    if (input.duck != recordedDuck) {
+        append(frame, input.duck ? EventDuckPress : EventDuckRelease);
+        recordedDuck = input.duck;
+    }
+}
+
+void InputLog::rewind() {
+    cursor = 0;
+    replayState = InputState();
+}
+
+InputState InputLog::replay(quint32 frame) {
+    replayState.jump = false;
+    while (cursor < entries.size() && entries[cursor].frame <= frame) {
+        switch (entries[cursor].event) {
+        case EventJump:
+            replayState.jump = entries[cursor].frame == frame;
+            break;
+        case EventDuckPress:
+            replayState.duck = true;
+            break;
+        case EventDuckRelease:
+            replayState.duck = false;
+            break;
+        default:
+            break;
+        }
+        ++cursor;
+    }
+    return replayState;
+}
+
+void InputLog::append(quint32 frame, Event event) {
+    entries.push_back({frame, event});
+}
+
+void InputLog::finish(quint32 frame, quint32 score) {
+    finished = true;
+    finalFrame = frame;
+    finalScore = score;
+}
+
+bool InputLog::save(const QString &path) const {
+    QByteArray data;
+    data.append(magic, sizeof(magic));
+    data.append(static_cast<char>(version));
+    for (int i = 0; i < 4; ++i) {
+        data.append(static_cast<char>((seed >> (8 * i)) & 0xFF));
+    }
+    const QByteArray coursePath = course.toUtf8();
+    putVarint(data, static_cast<quint32>(coursePath.size()));
+    data.append(coursePath);
+    quint32 lastFrame = 0;
+    for (const Entry &e : entries) {
+        putVarint(data, e.frame - lastFrame);
+        data.append(static_cast<char>(e.event));
+        lastFrame = e.frame;
+    }
+    if (finished) {
+        putVarint(data, finalFrame - lastFrame);
+        data.append(static_cast<char>(EventEnd));
+        putVarint(data, finalScore);
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(data) == data.size();
+}
+
+bool InputLog::load(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray data = file.readAll();
+    if (data.size() < 9 || data[0] != magic[0] || data[1] != magic[1] || data[2] != magic[2] || data[3] != magic[3]
+        || static_cast<quint8>(data[4]) != version) {
+        return false;
+    }
+
+    begin(0);
+    for (int i = 0; i < 4; ++i) {
+        seed |= static_cast<quint32>(static_cast<quint8>(data[5 + i])) << (8 * i);
+    }
+    qsizetype pos = 9;
+    quint32 courseBytes;
+    if (!getVarint(data, pos, courseBytes) || courseBytes > static_cast<quint64>(data.size() - pos)) {
+        return false;
+    }
+    course = QString::fromUtf8(data.constData() + pos, courseBytes);
+    pos += courseBytes;
+    quint32 frame = 0;
+    while (pos < data.size()) {
+        quint32 delta;
+        if (!getVarint(data, pos, delta) || pos >= data.size()) {
+            return false;
+        }
+        frame += delta;
+        const auto event = static_cast<Event>(static_cast<quint8>(data[pos++]));
+        if (event == EventEnd) {
+            quint32 score;
+            if (!getVarint(data, pos, score)) {
+                return false;
+            }
+            finish(frame, score);
+            break;
+        }
+        if (event > EventDuckRelease) {
+            return false;
+        }
+        append(frame, event);
+    }
+    return true;
+}
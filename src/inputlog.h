@@ -0,0 +1,96 @@
+#ifndef INPUTLOG_H
+#define INPUTLOG_H
+
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+#include "gameworld.h"
+
+/**
+ * 紧凑的二进制输入日志：记录一局的随机种子、所用障碍赛道与 (帧号, 按键事件) 序列，
+ * 以及死亡时的帧号与分数。配合确定性的 GameWorld 可以逐帧重放整局，
+ * 用于复现问题和作为性能回归负载。
+ *
+ * 文件格式（小端）：
+ *   "DINO" 魔数 | u8 版本 | u32 种子 | varint 赛道路径字节数 + UTF-8 赛道路径（随机生成时为 0） |
+ *   记录若干：varint 帧号增量 + u8 事件 |
+ *   结束记录：varint 帧号增量（到死亡帧）+ u8 EventEnd + varint 最终分数
+ */
+class InputLog {
+public:
+    enum Event : quint8 {
+        EventEnd = 0,         // 结束标记（死亡）
+        EventJump = 1,        // 跳跃
+        EventDuckPress = 2,   // 按下下蹲
+        EventDuckRelease = 3  // 松开下蹲
+    };
+
+    struct Entry {
+        quint32 frame; // 事件生效的模拟步序号（即该步之前的 frameCount）
+        Event event;
+    };
+
+    /**
+     * 清空并开始新的一局。
+     * @param value 本局随机种子。
+     */
+    void begin(quint32 value);
+
+    /**
+     * 记录本局载入的障碍赛道（begin() 会清空），重放前需载入同一赛道。
+     * @param path 赛道文件路径，为空表示随机生成。
+     */
+    void setCourse(const QString &path) { course = path; }
+
+    /**
+     * 录制一步的输入：跳跃记为事件，下蹲只在按住状态变化时记录。
+     * @param frame 模拟步序号。
+     * @param input 该步输入。
+     */
+    void record(quint32 frame, const InputState &input);
+
+    /** 把重放游标移回开头。 */
+    void rewind();
+
+    /**
+     * 重放：返回某一步应使用的输入（帧号需按顺序递增调用）。
+     * @param frame 模拟步序号。
+     */
+    InputState replay(quint32 frame);
+
+    /**
+     * 追加一个事件（帧号需单调不减）。
+     * @param frame 模拟步序号。
+     * @param event 事件。
+     */
+    void append(quint32 frame, Event event);
+
+    /**
+     * 记录本局结果。
+     * @param frame 死亡时的 frameCount。
+     * @param score 死亡时的分数。
+     */
+    void finish(quint32 frame, quint32 score);
+
+    bool save(const QString &path) const;
+    bool load(const QString &path);
+
+    [[nodiscard]] quint32 getSeed() const { return seed; }
+    [[nodiscard]] const QString &getCourse() const { return course; }
+    [[nodiscard]] const std::vector<Entry> &getEntries() const { return entries; }
+    [[nodiscard]] bool isFinished() const { return finished; }
+    [[nodiscard]] quint32 getFinalFrame() const { return finalFrame; }
+    [[nodiscard]] quint32 getFinalScore() const { return finalScore; }
+private:
+    quint32 seed = 0;
+    QString course; // 障碍赛道路径（为空为随机生成）
+    std::vector<Entry> entries;
+    bool finished = false;
+    quint32 finalFrame = 0;
+    quint32 finalScore = 0;
+    bool recordedDuck = false; // 录制时最近一次记录的下蹲状态
+    size_t cursor = 0;         // 重放游标
+    InputState replayState;    // 重放时的当前输入
+};
+
+#endif // INPUTLOG_H
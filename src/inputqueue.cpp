@@ -0,0 +1,54 @@
+#include "inputqueue.h"
+#include <algorithm>
+
+qint64 InputQueue::toClock(quint64 eventMs, qint64 nowNs) {
+    if (eventMs == 0) {
+        return std::max(nowNs, lastNs);
+    }
+    const qint64 eventNs = static_cast<qint64>(eventMs) * 1000000;
+    const qint64 offset = nowNs - eventNs;
+    if (!synced || offset < clockOffsetNs) {
+        clockOffsetNs = offset; // least-delayed delivery so far
+        synced = true;
+    }
+    return std::clamp(eventNs + clockOffsetNs, lastNs, std::max(nowNs, lastNs));
+}
+
+void InputQueue::push(qint64 timeNs, Kind kind) {
+    if (count == capacity) {
+        return;
+    }
+    lastNs = std::max(lastNs, timeNs);
+    events[(head + count) & (capacity - 1)] = {lastNs, kind};
+    ++count;
+}
+
+InputState InputQueue::take(qint64 endNs, qint64 *earliestNs) {
+    InputState in;
+    if (count > 0 && earliestNs && events[head].timeNs <= endNs) {
+        *earliestNs = events[head].timeNs;
+    }
+    while (count > 0 && events[head].timeNs <= endNs) {
+        switch (events[head].kind) {
+        case KindJump:
+            in.jump = true;
+            break;
+        case KindDuckPress:
+            duck = true;
+            break;
+        case KindDuckRelease:
+            duck = false;
+            break;
+        }
+        head = (head + 1) & (capacity - 1);
+        --count;
+    }
+    in.duck = duck;
+    return in;
+}
+
+void InputQueue::clear() {
+    head = 0;
+    count = 0;
+    duck = false;
+}
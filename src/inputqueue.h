@@ -0,0 +1,70 @@
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include <QtGlobal>
+#include <array>
+#include "gameworld.h"
+
+/**
+ * 带时间戳的输入队列：按键事件带着发生时刻入队，主循环按每个模拟步覆盖的时间区间取出，
+ * 合成该步的 InputState。输入因此落在它真正所属的模拟步上，
+ * 而不是事件到达后恰好执行的第一步（卡顿追赶多步时尤其明显），也不受定时器相位影响。
+ *
+ * 时间统一使用调用方的单调时钟（纳秒）；toClock() 负责把事件自带的毫秒时间戳换算过来。
+ * 固定容量的环形缓冲区，入队与取出都不分配内存。
+ */
+class InputQueue {
+public:
+    enum Kind : quint8 {
+        KindJump = 0,     // 按下跳跃
+        KindDuckPress,    // 按下下蹲
+        KindDuckRelease   // 松开下蹲
+    };
+
+    /** 最多缓存的未处理事件数（2 的幂）；超出时丢弃新事件。 */
+    static constexpr int capacity = 64;
+
+    /**
+     * 把事件时间戳（毫秒，事件系统时基）换算到调用方时钟（纳秒）。
+     * 两个时钟之差取迄今观测到的最小值（即投递延迟最小的那次），
+     * 结果不晚于 nowNs、不早于上一个入队事件。时间戳为 0（平台不提供）时返回 nowNs。
+     * @param eventMs QKeyEvent::timestamp()。
+     * @param nowNs 调用方时钟的当前读数。
+     */
+    qint64 toClock(quint64 eventMs, qint64 nowNs);
+
+    /**
+     * 入队一个事件（时间需单调不减，早于队尾的按队尾时间处理）。
+     * @param timeNs 事件时刻（调用方时钟）。
+     * @param kind 事件类型。
+     */
+    void push(qint64 timeNs, Kind kind);
+
+    /**
+     * 取出时刻不晚于 endNs 的全部事件，合成一个模拟步的输入：
+     * 期间任一跳跃按下即触发跳跃，下蹲取最后一个下蹲事件后的按住状态（无事件时保持）。
+     * @param endNs 该模拟步覆盖区间的结束时刻。
+     * @param earliestNs 可选输出：本次取出的最早事件时刻，无事件时不写。
+     */
+    InputState take(qint64 endNs, qint64 *earliestNs = nullptr);
+
+    /** 清空未处理事件并松开下蹲（重开时）。 */
+    void clear();
+
+    [[nodiscard]] bool empty() const { return count == 0; }
+private:
+    struct Event {
+        qint64 timeNs;
+        Kind kind;
+    };
+
+    std::array<Event, capacity> events{};
+    int head = 0;  // 队头物理槽位
+    int count = 0; // 未处理事件数
+    bool duck = false;           // 当前下蹲按住状态
+    qint64 lastNs = 0;           // 队尾事件时刻
+    bool synced = false;         // 是否已有时钟差估计
+    qint64 clockOffsetNs = 0;    // 调用方时钟 - 事件时钟 的最小观测值
+};
+
+#endif // INPUTQUEUE_H
@@ -0,0 +1,211 @@
+#ifndef JUMPTABLE_H
+#define JUMPTABLE_H
+
+#include <algorithm>
+#include <array>
+#include "gameconfig.h"
+#include "spritecache.h"
+
+/**
+ * 跳跃可达性表（编译期由 dinoJumpSpeed、dinoGravity 与碰撞尺寸推导，运行时只查表）。
+ *
+ * 时间以模拟步为单位，τ = 0 为当前步开始，τ = n 为之后第 n 步结束。若在当前步起跳，
+ * τ = n 时恐龙离地 arcHeight(n)；障碍左边界在 τ 时位于 x - speed·τ。
+ * 障碍与恐龙碰撞矩形的水平区间相交的时间段被采样点 [k0, k1]（向外取整）覆盖，
+ * 只要这些采样点上恐龙都不低于所需高度，步间线性插值的扫掠判定也不会命中。
+ * 模型只用包围盒（像素级判定只会更宽松），是一个保守的越过包络。
+ *
+ * 障碍分两类：底边高于下蹲恐龙顶部的（高飞的鸟）按住下蹲即可，其余必须跳过，
+ * 所需高度 need 为障碍顶边到站立恐龙底边的距离。
+ */
+namespace JumpTable {
+
+/** 起跳后 n 步结束时的离地高度（n = 0 为起跳前）。 */
+constexpr int arcHeight(int n) {
+    return -GameConfig::dinoJumpSpeed * n - GameConfig::dinoGravity * n * (n - 1) / 2;
+}
+
+/** 一次跳跃的滞空步数：起跳后第 airFrames 步落地，下一步才能再跳。 */
+constexpr int airFrames = [] {
+    int n = 1;
+    while (arcHeight(n) > 0) {
+        ++n;
+    }
+    return n;
+}();
+
+/** 最高离地高度。 */
+constexpr int peakHeight = [] {
+    int peak = 0;
+    for (int n = 0; n < airFrames; ++n) {
+        peak = std::max(peak, arcHeight(n));
+    }
+    return peak;
+}();
+
+/** 离地高度不低于某值的采样区间 [first, last]（first > last 表示够不到）。 */
+struct Window {
+    int first;
+    int last;
+};
+
+/** 下标为所需高度 need ∈ [0, peakHeight + 1]。 */
+constexpr int needCount = peakHeight + 2;
+
+constexpr std::array<Window, needCount> windows = [] {
+    std::array<Window, needCount> table{};
+    for (int need = 0; need < needCount; ++need) {
+        Window w{1, 0};
+        for (int n = 1; n < airFrames; ++n) {
+            if (arcHeight(n) >= need) {
+                w.first = w.last == 0 ? n : w.first;
+                w.last = n;
+            }
+        }
+        table[static_cast<size_t>(need)] = w;
+    }
+    return table;
+}();
+
+// 恐龙碰撞矩形（见 Dino::boundingRect）
+constexpr int dinoLeft = GameConfig::dinoX + GameConfig::collisionInsetX;
+constexpr int dinoSpan = GameConfig::dinoWidth - 2 * GameConfig::collisionInsetX;
+constexpr int dinoRight = dinoLeft + dinoSpan - 1;
+constexpr int standBottom = GameConfig::dinoGroundY + GameConfig::dinoHeight - GameConfig::collisionInsetY - 1;
+constexpr int duckTop = GameConfig::dinoGroundY + GameConfig::dinoDuckYOffset + GameConfig::collisionInsetY;
+
+/**
+ * 宽 width 的障碍以 speed 移动时，与恐龙水平相交所覆盖的采样点数上限。
+ */
+constexpr int samples(int speed, int width) {
+    return (dinoSpan + width + speed - 1) / speed + 1;
+}
+
+/**
+ * 越过包络：[speed][need] 为一次跳跃能越过的最宽障碍（像素），-1 表示够不到。
+ * 即 samples(speed, width) 不超过窗口长度的最大 width。
+ */
+constexpr std::array<std::array<int, needCount>, GameConfig::maxGameSpeed + 1> maxWidths = [] {
+    std::array<std::array<int, needCount>, GameConfig::maxGameSpeed + 1> table{};
+    for (int speed = 0; speed <= GameConfig::maxGameSpeed; ++speed) {
+        for (int need = 0; need < needCount; ++need) {
+            const Window &w = windows[static_cast<size_t>(need)];
+            const int length = w.last - w.first + 1;
+            table[static_cast<size_t>(speed)][static_cast<size_t>(need)] =
+                speed > 0 && length > 0 ? std::max((length - 1) * speed - dinoSpan, -1) : -1;
+        }
+    }
+    return table;
+}();
+
+static_assert(peakHeight > GameConfig::dinoHeight, "a jump must clear at least a dino-sized obstacle");
+
+/** 一个障碍的越过方式。 */
+struct Hurdle {
+    bool duck; // 下蹲即可躲过
+    int need;  // 需要跳过时的最低离地高度（已截断到 [1, peakHeight + 1]）
+    int width; // 宽度（像素）
+};
+
+/** 按障碍矩形分类。 */
+constexpr Hurdle hurdle(int y, int width, int height) {
+    return {y + height <= duckTop, std::clamp(standBottom + 1 - y, 1, peakHeight + 1), width};
+}
+
+/** 单个障碍能否在该速度下越过：O(1) 查包络表。 */
+constexpr bool clearable(int speed, const Hurdle &h) {
+    return h.duck || h.width <= maxWidths[static_cast<size_t>(speed)][static_cast<size_t>(h.need)];
+}
+
+/**
+ * 相继两个障碍 a、b 左边界之间至少相隔多少步（距离除以速度），才能用“能起跳就尽早起跳”的策略连续越过。
+ * 以 a 的最晚结束采样点与 b 的最早开始采样点估计（都向不利方向取整）：
+ * - 跳过 a 后，恐龙须在 b 的最早起跳时刻（跳 b）或 b 到达时（蹲 b）之前落地；
+ * - 蹲过 a 后，b 的最早起跳时刻不能早于 a 离开（空中的恐龙会撞上高飞的鸟）；
+ * - 两个都下蹲时没有约束。
+ * 每一对都满足时，贪心策略总能在每个障碍的最早起跳时刻起跳，对整个障碍序列成立。
+ */
+constexpr int spacingFrames(int speed, const Hurdle &a, const Hurdle &b) {
+    if (a.duck && b.duck) {
+        return 0;
+    }
+    const int airborne = a.duck ? 0 : airFrames - windows[static_cast<size_t>(a.need)].last; // 最早起跳后余下的滞空
+    const int leadB = b.duck ? 0 : windows[static_cast<size_t>(b.need)].last;               // b 的最早起跳提前量
+    return samples(speed, a.width) - 1 + airborne + leadB;
+}
+
+/** 仙人掌某种类某档位（放置与 GameWorld::spawn 一致：底边对齐赛道）。 */
+constexpr Hurdle cactusHurdle(int kind, int bucket) {
+    const SpriteCache::Size size = SpriteCache::cactusSize(kind, bucket);
+    return hurdle(GameConfig::groundY - size.height + GameConfig::groundAlignOffset, size.width, size.height);
+}
+
+/** 鸟某档位、某飞行高度（中心距地），包围盒取第 0 帧。 */
+constexpr Hurdle birdHurdle(int bucket, int flightY) {
+    const SpriteCache::Size size = SpriteCache::birdSize(0, bucket);
+    return hurdle(GameConfig::groundY + GameConfig::groundAlignOffset - flightY - size.height / 2, size.width, size.height);
+}
+
+/** 随机生成可能产生的全部障碍：每种仙人掌每档位，每档位的鸟各两种高度。 */
+constexpr int randomHurdleCount = SpriteCache::scaleBuckets * (SpriteCache::cactusKinds + 2);
+
+constexpr std::array<Hurdle, randomHurdleCount> randomHurdles = [] {
+    std::array<Hurdle, randomHurdleCount> table{};
+    size_t n = 0;
+    for (int bucket = 0; bucket < SpriteCache::scaleBuckets; ++bucket) {
+        for (int kind = 0; kind < SpriteCache::cactusKinds; ++kind) {
+            table[n++] = cactusHurdle(kind, bucket);
+        }
+        table[n++] = birdHurdle(bucket, GameConfig::birdHeightLow);
+        table[n++] = birdHurdle(bucket, GameConfig::birdHeightHigh);
+    }
+    return table;
+}();
+
+/** 每个随机障碍在 [gameSpeed, maxGameSpeed] 的每个速度下都能越过。 */
+constexpr bool randomHurdlesClearable() {
+    for (int speed = GameConfig::gameSpeed; speed <= GameConfig::maxGameSpeed; ++speed) {
+        for (const Hurdle &h : randomHurdles) {
+            if (!clearable(speed, h)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/** 某速度下任意两个随机障碍相继出现时所需的最大间距（步）。 */
+constexpr int maxSpacingFrames(int speed) {
+    int worst = 0;
+    for (const Hurdle &a : randomHurdles) {
+        for (const Hurdle &b : randomHurdles) {
+            worst = std::max(worst, spacingFrames(speed, a, b));
+        }
+    }
+    return worst;
+}
+
+/**
+ * 随机生成的间隔足以满足最大间距：两次生成之间前一个障碍至少移动 spawnIntervalMin 步，
+ * 一个间隔内速度最多提升 1，每步至少 speed - 1 像素；这段距离不小于按当前速度换算的最大间距时，
+ * spawnX 不会推迟任何随机障碍。
+ */
+constexpr bool spawnIntervalSuffices() {
+    for (int speed = GameConfig::gameSpeed; speed <= GameConfig::maxGameSpeed; ++speed) {
+        if (maxSpacingFrames(speed) * speed > GameConfig::spawnIntervalMin * (speed - 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 三条都成立时 spawnX 对随机生成是恒等的：调整参数或贴图后若不再成立，编译失败，
+// 而不是悄悄改变同一种子的障碍序列（输入日志随之失效）
+static_assert(GameConfig::speedRampFrames >= GameConfig::spawnIntervalMax,
+              "the spacing bound assumes at most one speed step per spawn interval");
+static_assert(randomHurdlesClearable(), "a random obstacle cannot be cleared at some speed");
+static_assert(spawnIntervalSuffices(), "spawnIntervalMin is shorter than the spacing some obstacle pair needs");
+
+} // namespace JumpTable
+
+#endif // JUMPTABLE_H
@@ -1,14 +1,81 @@
+#include "framecapture.h"
 #include "gamewindow.h"
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <cstring>
 
 /**
  * 应用入口：创建 QApplication 与主窗口并进入事件循环。
+ * 从进入 main() 到第一帧绘制完成的启动耗时写入帧分析器（startup 阶段）并打印；
+ * 指定 --profile-out 时，退出后把帧分析样本导出为 CSV；
+ * --record 把每局输入录制到文件，--seed 固定每局的随机种子，--course 按赛道文件生成障碍；
+ * --capture 不创建窗口，在 offscreen 平台上离屏录制 PNG 序列或原始 RGBA 视频流。
  * @param argc 参数数量（Qt 传入）。
  * @param argv 参数数组（Qt 传入）。
  */
 int main(int argc, char* argv[]) {
+    QElapsedTimer launchClock; // startup metric: launch to first painted frame
+    launchClock.start();
+    // the platform plugin is chosen when QApplication is constructed, before options are parsed
+    for (int i = 1; i < argc; ++i) {
+        // exact option only: --capture-frames/--capture-threads alone must not hide the window
+        const bool capture = std::strcmp(argv[i], "--capture") == 0 || std::strncmp(argv[i], "--capture=", 10) == 0;
+        if (capture && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+    }
     QApplication a(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption profileOutOption("profile-out", "Write per-phase frame timings to a CSV file on exit.", "file");
+    parser.addOption(profileOutOption);
+    QCommandLineOption recordOption("record", "Record the seed and inputs of each run to a file (last run wins).", "file");
+    parser.addOption(recordOption);
+    QCommandLineOption seedOption("seed", "Start every run with this random seed.", "n");
+    parser.addOption(seedOption);
+    QCommandLineOption courseOption("course", "Spawn obstacles from a course file instead of at random.", "file");
+    parser.addOption(courseOption);
+    QCommandLineOption captureOption("capture", "Render headless to a PNG directory, a .rgba file or '-' (raw RGBA on stdout).", "path");
+    parser.addOption(captureOption);
+    QCommandLineOption captureFramesOption("capture-frames", "Number of frames to capture.", "n", "600");
+    parser.addOption(captureFramesOption);
+    QCommandLineOption captureThreadsOption("capture-threads", "Encoder threads (default: all cores).", "n", "0");
+    parser.addOption(captureThreadsOption);
+    QCommandLineOption replayOption("replay", "Drive the capture from a recorded input log instead of the autopilot.", "file");
+    parser.addOption(replayOption);
+    parser.process(a);
+
+    if (parser.isSet(captureOption)) {
+        FrameCapture::Options options;
+        options.output = parser.value(captureOption);
+        options.frames = parser.value(captureFramesOption).toInt();
+        options.threads = parser.value(captureThreadsOption).toInt();
+        options.seeded = parser.isSet(seedOption);
+        options.seed = parser.value(seedOption).toUInt();
+        options.replay = parser.value(replayOption);
+        options.course = parser.value(courseOption);
+        return FrameCapture(options).run();
+    }
+
     GameWindow w;
+    w.setLaunchClock(launchClock);
+    if (parser.isSet(seedOption)) {
+        w.setSeed(parser.value(seedOption).toUInt());
+    }
+    w.setRecordPath(parser.value(recordOption));
+    if (parser.isSet(courseOption)) {
+        w.setCoursePath(parser.value(courseOption));
+    }
     w.show();
-    return QApplication::exec();
+    const int ret = QApplication::exec();
+
+    if (parser.isSet(profileOutOption)) {
+        const QString path = parser.value(profileOutOption);
+        if (!w.getProfiler().writeCsv(path)) {
+            qWarning("Failed to write profile to %s", qPrintable(path));
+        }
+    }
+    return ret;
 }
\ No newline at end of file
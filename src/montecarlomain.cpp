@@ -0,0 +1,149 @@
+#include "autopilot.h"
+#include "gameworld.h"
+#include "gameconfig.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QThreadPool>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int keptFailures = 10; // 每段最多记录的死亡种子数
+
+/** 一段种子的统计结果，各段互不共享，结束后汇总。 */
+struct Tally {
+    std::vector<qint64> deaths;    // 按 binFrames 分桶的死亡帧数
+    qint64 survived = 0;           // 活到帧数上限的局数
+    qint64 frames = 0;             // 累计模拟帧数
+    std::array<qint64, 3> causes{}; // 按 GameWorld::DeathCause 计数
+    std::vector<quint32> failures; // 本段最先死亡的若干种子
+};
+
+/**
+ * 用完美玩家依次跑 [first, first + count) 的每个种子，直到死亡或达到帧数上限。
+ */
+void runSeeds(const std::shared_ptr<const SpriteCache> &sprites, quint32 first, qint64 count,
+              int maxFrames, int binFrames, Tally &out) {
+    GameWorld world(sprites);
+    out.deaths.assign(static_cast<size_t>(maxFrames / binFrames + 1), 0);
+    for (qint64 k = 0; k < count; ++k) {
+        const quint32 seed = first + static_cast<quint32>(k);
+        world.reset(seed);
+        world.start();
+        while (!world.gameOver() && world.getFrameCount() < maxFrames) {
+            world.step(perfectPilot(world));
+        }
+        out.frames += world.getFrameCount();
+        if (!world.gameOver()) {
+            ++out.survived;
+            continue;
+        }
+        ++out.deaths[static_cast<size_t>(world.getFrameCount() / binFrames)];
+        ++out.causes[world.getDeathCause()];
+        if (static_cast<int>(out.failures.size()) < keptFailures) {
+            out.failures.push_back(seed);
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * 生成公平性的蒙特卡罗检验：按跳跃可达性表操作的完美玩家在大量种子上各跑一局，
+ * 种子按段分给线程池并行执行（每段一个世界，共享贴图缓存），输出存活帧数分布。
+ * 生成逻辑公平时完美玩家应全部活到帧数上限；出现死亡时列出最先死亡的种子，
+ * 可用 --first-seed <种子> --seeds 1 单独复现。
+ */
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("dino_montecarlo");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Survival distribution of a perfect-play bot over many seeds");
+    parser.addHelpOption();
+    QCommandLineOption seedsOption("seeds", "Number of seeds (one run each).", "n", "1000000");
+    parser.addOption(seedsOption);
+    QCommandLineOption firstSeedOption("first-seed", "First seed; run k uses first-seed + k.", "n", "1");
+    parser.addOption(firstSeedOption);
+    QCommandLineOption maxFramesOption("max-frames", "Frame cap per run (top speed is reached after "
+                                       + QString::number(GameConfig::speedRampFrames * (GameConfig::maxGameSpeed - GameConfig::gameSpeed))
+                                       + ").", "n", "6000");
+    parser.addOption(maxFramesOption);
+    QCommandLineOption binOption("bin", "Histogram bin width in frames.", "n", "300");
+    parser.addOption(binOption);
+    QCommandLineOption threadsOption("threads", "Worker threads (default: all cores).", "n");
+    parser.addOption(threadsOption);
+    parser.process(app);
+
+    const qint64 seeds = std::max<qint64>(parser.value(seedsOption).toLongLong(), 1);
+    const quint32 firstSeed = parser.value(firstSeedOption).toUInt();
+    const int maxFrames = std::max(parser.value(maxFramesOption).toInt(), 1);
+    const int binFrames = std::max(parser.value(binOption).toInt(), 1);
+    QThreadPool pool;
+    if (parser.isSet(threadsOption)) {
+        pool.setMaxThreadCount(std::max(parser.value(threadsOption).toInt(), 1));
+    }
+
+    // several chunks per thread so uneven run lengths still balance
+    auto sprites = std::make_shared<const SpriteCache>();
+    const qint64 chunks = std::min<qint64>(seeds, static_cast<qint64>(pool.maxThreadCount()) * 16);
+    std::vector<Tally> tallies(static_cast<size_t>(chunks));
+    QElapsedTimer clock;
+    clock.start();
+    for (qint64 c = 0; c < chunks; ++c) {
+        const qint64 begin = seeds * c / chunks;
+        const qint64 end = seeds * (c + 1) / chunks;
+        Tally *tally = &tallies[static_cast<size_t>(c)];
+        pool.start([&sprites, firstSeed, begin, end, maxFrames, binFrames, tally] {
+            runSeeds(sprites, firstSeed + static_cast<quint32>(begin), end - begin, maxFrames, binFrames, *tally);
+        });
+    }
+    pool.waitForDone();
+    const qint64 elapsedNs = qMax<qint64>(clock.nsecsElapsed(), 1);
+
+    Tally total;
+    total.deaths.assign(static_cast<size_t>(maxFrames / binFrames + 1), 0);
+    for (const Tally &t : tallies) {
+        for (size_t i = 0; i < t.deaths.size(); ++i) {
+            total.deaths[i] += t.deaths[i];
+        }
+        total.survived += t.survived;
+        total.frames += t.frames;
+        for (size_t i = 0; i < t.causes.size(); ++i) {
+            total.causes[i] += t.causes[i];
+        }
+        total.failures.insert(total.failures.end(), t.failures.begin(), t.failures.end());
+    }
+    std::sort(total.failures.begin(), total.failures.end());
+    total.failures.resize(std::min<size_t>(total.failures.size(), keptFailures));
+
+    QTextStream out(stdout);
+    out << "seeds: " << seeds << " threads: " << pool.maxThreadCount() << " max frames: " << maxFrames << '\n';
+    out << "frames,deaths,survival\n";
+    qint64 alive = seeds;
+    for (size_t i = 0; i < total.deaths.size(); ++i) {
+        alive -= total.deaths[i];
+        const qint64 binEnd = std::min<qint64>(static_cast<qint64>(i + 1) * binFrames, maxFrames);
+        out << binEnd << ',' << total.deaths[i] << ',' << QString::number(double(alive) / double(seeds), 'f', 6) << '\n';
+        if (binEnd >= maxFrames) {
+            break;
+        }
+    }
+
+    out << "survived: " << total.survived << " (" << QString::number(100.0 * double(total.survived) / double(seeds), 'f', 4) << "%)\n";
+    out << "deaths: cactus " << total.causes[GameWorld::DeathCactus] << " bird " << total.causes[GameWorld::DeathBird] << '\n';
+    out << "first failing seeds:";
+    for (quint32 seed : total.failures) {
+        out << ' ' << seed;
+    }
+    out << (total.failures.empty() ? " none\n" : "\n");
+    out << "elapsed ms: " << elapsedNs / 1000000.0 << '\n';
+    out << "runs/s: " << double(seeds) * 1e9 / double(elapsedNs) << '\n';
+    out << "frames/s: " << double(total.frames) * 1e9 / double(elapsedNs) << '\n';
+    return total.survived == seeds ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+#include "obstaclecourse.h"
+#include <QString>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+constexpr char magic[4] = {'D', 'C', 'R', 'S'};
+constexpr quint16 version = 1;
+constexpr qint64 headerSize = 16;
+constexpr qint64 entrySize = 8;
+constexpr qint64 countOffset = 8;          // 文件头中条数字段的偏移
+constexpr qsizetype flushBytes = 64 * 1024; // 写入缓冲达到此大小时落盘
+
+void put16(uchar *p, quint16 v) {
+    p[0] = static_cast<uchar>(v);
+    p[1] = static_cast<uchar>(v >> 8);
+}
+
+void put32(uchar *p, quint32 v) {
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<uchar>(v >> (8 * i));
+    }
+}
+
+quint16 get16(const uchar *p) {
+    return static_cast<quint16>(p[0] | (p[1] << 8));
+}
+
+quint32 get32(const uchar *p) {
+    return quint32(p[0]) | quint32(p[1]) << 8 | quint32(p[2]) << 16 | quint32(p[3]) << 24;
+}
+
+} // namespace
+
+ObstacleCourse::~ObstacleCourse() {
+    close();
+}
+
+/**
+ * 打开：条数取文件头与文件实际长度中较小者，截断的文件只读到完整的记录为止。
+ */
+bool ObstacleCourse::open(const QString &path) {
+    close();
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    uchar header[headerSize];
+    if (file.read(reinterpret_cast<char *>(header), headerSize) != headerSize
+        || std::memcmp(header, magic, sizeof(magic)) != 0 || get16(header + 4) != version
+        || get16(header + 6) != entrySize) {
+        close();
+        return false;
+    }
+    const qint64 stored = (file.size() - headerSize) / entrySize;
+    count = static_cast<int>(std::min<qint64>({get32(header + countOffset), stored, std::numeric_limits<int>::max()}));
+    seed = get32(header + 12);
+    return true;
+}
+
+void ObstacleCourse::close() {
+    if (window) {
+        file.unmap(window);
+        window = nullptr;
+    }
+    if (file.isOpen()) {
+        file.close();
+    }
+    windowFirst = 0;
+    windowCount = 0;
+    count = 0;
+    seed = 0;
+}
+
+bool ObstacleCourse::at(int i, Entry &out) {
+    if (i < 0 || i >= count) {
+        return false;
+    }
+    if ((i < windowFirst || i >= windowFirst + windowCount) && !mapWindow(i)) {
+        return false;
+    }
+    const uchar *p = window + static_cast<qint64>(i - windowFirst) * entrySize;
+    out.frame = get32(p);
+    out.type = static_cast<Type>(p[4]);
+    out.variant = p[5];
+    out.bucket = p[6];
+    out.height = p[7];
+    return true;
+}
+
+/**
+ * 窗口按 windowEntries 对齐，世界前进时只会向后移动，旧窗口解除映射后其页面即可回收。
+ */
+bool ObstacleCourse::mapWindow(int i) {
+    if (window) {
+        file.unmap(window);
+        window = nullptr;
+    }
+    windowFirst = i - i % windowEntries;
+    windowCount = std::min(windowEntries, count - windowFirst);
+    window = file.map(headerSize + static_cast<qint64>(windowFirst) * entrySize, windowCount * entrySize);
+    if (!window) {
+        windowCount = 0;
+    }
+    return window != nullptr;
+}
+
+/**
+ * 先写占位文件头（条数为 0），记录攒满缓冲再写，finish() 时回填条数。
+ */
+bool ObstacleCourseWriter::open(const QString &path, quint32 seed) {
+    file.setFileName(path);
+    count = 0;
+    buffer.clear();
+    ok = file.open(QIODevice::WriteOnly);
+    if (ok) {
+        uchar header[headerSize] = {};
+        std::memcpy(header, magic, sizeof(magic));
+        put16(header + 4, version);
+        put16(header + 6, entrySize);
+        put32(header + 12, seed);
+        ok = file.write(reinterpret_cast<const char *>(header), headerSize) == headerSize;
+    }
+    return ok;
+}
+
+bool ObstacleCourseWriter::append(const ObstacleCourse::Entry &entry) {
+    if (!ok) {
+        return false;
+    }
+    uchar p[entrySize];
+    put32(p, entry.frame);
+    p[4] = entry.type;
+    p[5] = entry.variant;
+    p[6] = entry.bucket;
+    p[7] = entry.height;
+    buffer.append(reinterpret_cast<const char *>(p), entrySize);
+    ++count;
+    if (buffer.size() >= flushBytes) {
+        ok = file.write(buffer) == buffer.size();
+        buffer.clear();
+    }
+    return ok;
+}
+
+bool ObstacleCourseWriter::finish() {
+    if (ok && !buffer.isEmpty()) {
+        ok = file.write(buffer) == buffer.size();
+        buffer.clear();
+    }
+    uchar bytes[4];
+    put32(bytes, static_cast<quint32>(count));
+    ok = ok && file.seek(countOffset) && file.write(reinterpret_cast<const char *>(bytes), 4) == 4;
+    if (!ok) {
+        file.cancelWriting();
+        file.commit();
+        return false;
+    }
+    return file.commit();
+}
@@ -0,0 +1,105 @@
+#ifndef OBSTACLECOURSE_H
+#define OBSTACLECOURSE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QSaveFile>
+#include <QtGlobal>
+
+class QString;
+
+/**
+ * 障碍赛道文件：按生成帧排列的定长障碍记录，用于手工编写的挑战关卡与“每日种子”赛道。
+ * 打开时只读 16 字节文件头；记录通过一个固定大小的滑动映射窗口按需读取，
+ * 世界向前推进时窗口随之后移，任意长度的赛道都能立即载入，常驻内存只有一个窗口。
+ *
+ * 文件格式（小端）：
+ *   文件头："DCRS" 魔数 | u16 版本 | u16 记录长度 | u32 条数 | u32 种子（由随机赛道导出时记录，手工编写为 0）
+ *   记录：u32 生成帧 | u8 类型 | u8 变体（仙人掌种类） | u8 缩放档位 | u8 高度（鸟中心距地像素）
+ */
+class ObstacleCourse {
+public:
+    enum Type : quint8 {
+        TypeCactus = 0, // 仙人掌，变体为 SpriteCache::cactusSpritePaths 下标
+        TypeBird        // 鸟，高度为中心距地面的像素
+    };
+
+    /** 一条障碍记录。 */
+    struct Entry {
+        quint32 frame = 0;  // 生成时的 frameCount（单调不减）
+        Type type = TypeCactus;
+        quint8 variant = 0; // 仙人掌种类
+        quint8 bucket = 0;  // 缩放档位 [0, scaleBuckets)
+        quint8 height = 0;  // 鸟的飞行高度（仙人掌忽略）
+    };
+
+    /** 映射窗口覆盖的记录条数。 */
+    static constexpr int windowEntries = 8192;
+
+    ObstacleCourse() = default;
+    ~ObstacleCourse();
+
+    ObstacleCourse(const ObstacleCourse &) = delete;
+    ObstacleCourse &operator=(const ObstacleCourse &) = delete;
+
+    /**
+     * 打开赛道文件并校验文件头（不读取记录）。
+     * @param path 文件路径。
+     * @return 文件不存在或文件头不合法时返回 false。
+     */
+    bool open(const QString &path);
+
+    /** 解除映射并关闭文件。 */
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return file.isOpen(); }
+    [[nodiscard]] int size() const { return count; }
+    [[nodiscard]] quint32 getSeed() const { return seed; }
+
+    /**
+     * 读取第 i 条记录；不在当前窗口内时把窗口移到 i 所在的位置。
+     * 顺序读取时每 windowEntries 条才重新映射一次。
+     * @param i 下标 [0, size())。
+     * @param out 输出记录。
+     * @return 映射失败时返回 false。
+     */
+    bool at(int i, Entry &out);
+private:
+    /** 映射包含第 i 条记录的窗口。 */
+    bool mapWindow(int i);
+
+    QFile file;
+    uchar *window = nullptr; // 当前窗口的映射
+    int windowFirst = 0;     // 窗口中第一条记录的下标
+    int windowCount = 0;     // 窗口中的记录条数
+    int count = 0;           // 记录总数
+    quint32 seed = 0;        // 文件头中的种子
+};
+
+/**
+ * 赛道文件的流式写入：记录逐条追加到临时文件，finish() 时回填条数并原子替换目标文件。
+ */
+class ObstacleCourseWriter {
+public:
+    /**
+     * 开始写入。
+     * @param path 目标文件路径。
+     * @param seed 写入文件头的种子。
+     */
+    bool open(const QString &path, quint32 seed);
+
+    /** 追加一条记录（帧号需单调不减）。 */
+    bool append(const ObstacleCourse::Entry &entry);
+
+    /** 回填条数并提交；未调用时目标文件保持不变。 */
+    bool finish();
+
+    [[nodiscard]] int size() const { return count; }
+private:
+    QSaveFile file;
+    QByteArray buffer; // 待写入的记录
+    int count = 0;
+    bool ok = false;   // 写入过程中没有出错
+};
+
+#endif // OBSTACLECOURSE_H
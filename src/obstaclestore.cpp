@@ -0,0 +1,37 @@
+#include "obstaclestore.h"
+
+void ObstacleStore::clear() {
+    xs.fill(0); // advance() also runs over idle slots; keep them far from overflow
+    head = 0;
+    count = 0;
+}
+
+bool ObstacleStore::push(SpriteCache::Handle sprite, int x, int y, int w, int h) {
+    if (full()) {
+        return false;
+    }
+    const int s = slot(count);
+    xs[s] = x;
+    ys[s] = y;
+    ws[s] = w;
+    hs[s] = h;
+    sprites[s] = sprite;
+    ++count;
+    return true;
+}
+
+void ObstacleStore::advance(int dx) {
+    for (int i = 0; i < capacity; ++i) {
+        xs[i] -= dx;
+    }
+}
+
+/**
+ * 退役：队头永远是最左的障碍，遇到第一个仍在屏幕内的即可停止。
+ */
+void ObstacleStore::retireOffscreen() {
+    while (count > 0 && xs[head] + ws[head] < 0) {
+        head = (head + 1) & (capacity - 1);
+        --count;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef OBSTACLESTORE_H
+#define OBSTACLESTORE_H
+
+#include <QRect>
+#include <array>
+#include "spritecache.h"
+
+/**
+ * 障碍存储：固定容量的环形缓冲区，x/y/w/h/贴图句柄分别存放在连续数组中（SoA）。
+ * 障碍总是从右侧进入、以相同速度向左移出，因此按生成顺序排列即按 x 递增排列，
+ * 只需从队头退役，O(1)。整个存储内嵌在对象里，游戏过程中没有任何堆分配。
+ *
+ * 逻辑下标 i ∈ [0, size()) 从队头（最左、最早生成）数起。
+ */
+class ObstacleStore {
+public:
+    /** 最大同时存在的障碍数（2 的幂，便于取模）。 */
+    static constexpr int capacity = 64;
+
+    /** 清空（不释放任何内存）。 */
+    void clear();
+
+    /**
+     * 在队尾追加一个障碍。
+     * @return 已满时返回 false，障碍被丢弃。
+     */
+    bool push(SpriteCache::Handle sprite, int x, int y, int w, int h);
+
+    /**
+     * 所有障碍左移 dx。对整段定长数组做无分支减法，便于编译器向量化；
+     * 空闲槽位一并被减，不影响结果。
+     * @param dx 移动距离（像素）。
+     */
+    void advance(int dx);
+
+    /** 从队头退役已完全移出左边界的障碍。 */
+    void retireOffscreen();
+
+    [[nodiscard]] int size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] bool full() const { return count == capacity; }
+
+    [[nodiscard]] int x(int i) const { return xs[slot(i)]; }
+    [[nodiscard]] int y(int i) const { return ys[slot(i)]; }
+    [[nodiscard]] int width(int i) const { return ws[slot(i)]; }
+    [[nodiscard]] int height(int i) const { return hs[slot(i)]; }
+    [[nodiscard]] SpriteCache::Handle sprite(int i) const { return sprites[slot(i)]; }
+    [[nodiscard]] QRect rect(int i) const { const int s = slot(i); return QRect(xs[s], ys[s], ws[s], hs[s]); }
+private:
+    /** 逻辑下标到物理槽位。 */
+    [[nodiscard]] int slot(int i) const { return (head + i) & (capacity - 1); }
+
+    std::array<int, capacity> xs{};
+    std::array<int, capacity> ys{};
+    std::array<int, capacity> ws{};
+    std::array<int, capacity> hs{};
+    std::array<SpriteCache::Handle, capacity> sprites{};
+    int head = 0;  // 队头物理槽位
+    int count = 0; // 存活障碍数
+};
+
+#endif // OBSTACLESTORE_H
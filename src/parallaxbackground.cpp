@@ -0,0 +1,147 @@
+#include "parallaxbackground.h"
+#include "assetloader.h"
+#include <QPainter>
+#include <QRandomGenerator>
+#include <QThreadPool>
+#include <algorithm>
+
+namespace {
+
+static_assert(GameConfig::parallaxStripWidth >= GameConfig::windowWidth, "a strip must cover the window");
+
+constexpr int hillMinHeight = 24;  // 远山最低高度（像素）
+constexpr int hillMinWidth = 120;  // 远山宽度范围
+constexpr int hillMaxWidth = 320;
+constexpr int pebbleMaxWidth = 6;  // 碎石最大尺寸
+constexpr int pebbleMaxHeight = 2;
+
+} // namespace
+
+/**
+ * 构造：先串行合成各层原色条带，再在线程池中并行生成各级别的换色/淡化版本；
+ * QPixmap 只能在界面线程创建，最后统一转换。
+ */
+ParallaxBackground::ParallaxBackground() {
+    const QImage cloud = AssetLoader::load(":/other/Cloud.png");
+    std::array<QImage, GameConfig::parallaxLayerCount> bases;
+    std::array<std::vector<QImage>, GameConfig::parallaxLayerCount> images;
+    for (int i = 0; i < GameConfig::parallaxLayerCount; ++i) {
+        const GameConfig::ParallaxLayer &layer = GameConfig::parallaxLayers[i];
+        const size_t index = static_cast<size_t>(i);
+        bases[index] = compose(layer, cloud);
+        heights[index] = bases[index].height();
+        images[index].resize(static_cast<size_t>(layer.kind == GameConfig::ParallaxClouds ? GameConfig::cloudFadeLevels
+                                                                                            : GameConfig::nightPaletteLevels));
+    }
+
+    QThreadPool pool;
+    for (int i = 0; i < GameConfig::parallaxLayerCount; ++i) {
+        const bool faded = GameConfig::parallaxLayers[i].kind == GameConfig::ParallaxClouds;
+        const size_t index = static_cast<size_t>(i);
+        for (size_t level = 0; level < images[index].size(); ++level) {
+            pool.start([&bases, &images, faded, index, level] {
+                const int value = static_cast<int>(level);
+                images[index][level] = faded ? DayNightCycle::fadedImage(bases[index], value + 1)
+                                             : DayNightCycle::paletteImage(bases[index], value);
+            });
+        }
+    }
+    pool.waitForDone();
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        for (const QImage &img : images[i]) {
+            strips[i].push_back(QPixmap::fromImage(img));
+        }
+    }
+}
+
+/**
+ * 合成条带：装饰物位置来自按层固定播种的生成器（与本局种子无关，每次启动画面相同）。
+ * 每个装饰物在 x 与 x - 条带宽度处各画一次，跨过右边界的部分出现在左端，首尾无缝相接。
+ */
+QImage ParallaxBackground::compose(const GameConfig::ParallaxLayer &layer, const QImage &cloud) {
+    constexpr int width = GameConfig::parallaxStripWidth;
+    int height = layer.span;
+    switch (layer.kind) {
+    case GameConfig::ParallaxHills:
+        height += hillMinHeight;
+        break;
+    case GameConfig::ParallaxClouds:
+        height += cloud.height();
+        break;
+    case GameConfig::ParallaxPebbles:
+        height += pebbleMaxHeight;
+        break;
+    }
+
+    QImage img(width, std::max(height, 1), QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::transparent);
+    QPainter painter(&img);
+    painter.setPen(Qt::NoPen);
+    QRandomGenerator rng(static_cast<quint32>(layer.kind) + 1);
+    for (int i = 0; i < layer.count; ++i) {
+        const int x = rng.bounded(width);
+        switch (layer.kind) {
+        case GameConfig::ParallaxHills: {
+            // a dome: the lower half of the ellipse falls outside the strip
+            const int w = rng.bounded(hillMinWidth, hillMaxWidth + 1);
+            const int h = hillMinHeight + rng.bounded(layer.span + 1);
+            painter.setRenderHint(QPainter::Antialiasing);
+            painter.setBrush(QColor(230, 230, 230));
+            for (int dx : {x, x - width}) {
+                painter.drawEllipse(QRect(dx, height - h, w, 2 * h));
+            }
+            break;
+        }
+        case GameConfig::ParallaxClouds: {
+            const int y = rng.bounded(layer.span + 1);
+            if (!cloud.isNull()) {
+                for (int dx : {x, x - width}) {
+                    painter.drawImage(dx, y, cloud);
+                }
+            }
+            break;
+        }
+        case GameConfig::ParallaxPebbles: {
+            const int y = rng.bounded(layer.span + 1);
+            const int w = rng.bounded(1, pebbleMaxWidth + 1);
+            const int h = rng.bounded(1, pebbleMaxHeight + 1);
+            for (int dx : {x, x - width}) {
+                painter.fillRect(dx, y, w, h, QColor(83, 83, 83));
+            }
+            break;
+        }
+        }
+    }
+    painter.end();
+    return img;
+}
+
+/**
+ * 偏移 = 地面偏移 × 滚动比例，两者都是 16.16 定点，乘积右移 32 位得到整数像素后对条带宽度取模。
+ */
+int ParallaxBackground::offset(int layer, qint64 groundFx) {
+    const qint64 scrolled = (groundFx * GameConfig::parallaxLayers[layer].factorFx) >> (2 * GameConfig::parallaxFixedShift);
+    const qint64 wrapped = scrolled % GameConfig::parallaxStripWidth;
+    return static_cast<int>(wrapped < 0 ? wrapped + GameConfig::parallaxStripWidth : wrapped);
+}
+
+void ParallaxBackground::draw(QPainter &painter, int layer, int offset, const DayNightCycle::State &sky) const {
+    const GameConfig::ParallaxLayer &config = GameConfig::parallaxLayers[layer];
+    const int level = config.kind == GameConfig::ParallaxClouds ? sky.cloudLevel - 1 : sky.paletteLevel;
+    if (level < 0) {
+        return; // clouds are hidden at night
+    }
+    const QPixmap &strip = strips[static_cast<size_t>(layer)][static_cast<size_t>(level)];
+    const int height = heights[static_cast<size_t>(layer)];
+    // the window shows strip columns [offset, offset + windowWidth), wrapping at most once
+    const int first = std::min(GameConfig::parallaxStripWidth - offset, GameConfig::windowWidth);
+    painter.drawPixmap(0, config.top, strip, offset, 0, first, height);
+    if (first < GameConfig::windowWidth) {
+        painter.drawPixmap(first, config.top, strip, 0, 0, GameConfig::windowWidth - first, height);
+    }
+}
+
+QRect ParallaxBackground::band(int layer) const {
+    return QRect(0, GameConfig::parallaxLayers[layer].top, GameConfig::windowWidth, heights[static_cast<size_t>(layer)]);
+}
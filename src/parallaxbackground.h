@@ -0,0 +1,56 @@
+#ifndef PARALLAXBACKGROUND_H
+#define PARALLAXBACKGROUND_H
+
+#include <QImage>
+#include <QPixmap>
+#include <QRect>
+#include <QtGlobal>
+#include <array>
+#include <vector>
+#include "daynightcycle.h"
+#include "gameconfig.h"
+
+class QPainter;
+
+/**
+ * 多层视差背景（远山、云朵、地面碎石，见 GameConfig::parallaxLayers）。
+ * 每层在启动时合成一条宽 parallaxStripWidth、首尾相接的条带，并为每个昼夜配色级别
+ * （云朵为每个淡化级别）各生成一份；绘制时按偏移从条带中切出窗口宽度，回卷处拆成两次贴图，
+ * 因此每层每帧最多两次 drawPixmap，与装饰物数量无关。
+ * 滚动偏移由地面偏移按 16.16 定点比例换算，低速时也能按亚像素累积平滑移动，
+ * 不需要世界保存任何背景状态。
+ */
+class ParallaxBackground {
+public:
+    /** 合成全部条带（需在 QGuiApplication 之后、界面线程中构造）。 */
+    ParallaxBackground();
+
+    /**
+     * 某层在给定地面偏移下的条带偏移。
+     * @param layer 层下标 [0, parallaxLayerCount)。
+     * @param groundFx 地面偏移（16.16 定点，可含插值的小数部分，不小于 0）。
+     * @return 条带内的起始列 [0, parallaxStripWidth)。
+     */
+    static int offset(int layer, qint64 groundFx);
+
+    /**
+     * 绘制一层：按昼夜状态选择条带，黑夜中隐藏的云朵层不绘制。
+     * @param painter 目标画家。
+     * @param layer 层下标。
+     * @param offset offset() 的返回值。
+     * @param sky 本帧昼夜状态。
+     */
+    void draw(QPainter &painter, int layer, int offset, const DayNightCycle::State &sky) const;
+
+    /** 某层在屏幕上的区域（偏移变化时需要重绘的范围）。 */
+    [[nodiscard]] QRect band(int layer) const;
+private:
+    /** 合成一层的原色条带。 */
+    static QImage compose(const GameConfig::ParallaxLayer &layer, const QImage &cloud);
+
+    /** 每层按级别排列的条带：云朵下标为淡化级别 - 1，其余为配色级别。 */
+    std::array<std::vector<QPixmap>, GameConfig::parallaxLayerCount> strips;
+    std::array<int, GameConfig::parallaxLayerCount> heights{}; // 各层条带高度
+};
+
+#endif // PARALLAXBACKGROUND_H
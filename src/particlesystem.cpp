@@ -0,0 +1,142 @@
+#include "particlesystem.h"
+#include <QPainter>
+#include <QtMath>
+#include <algorithm>
+
+ParticleSystem::ParticleSystem(int capacity) {
+    const auto n = static_cast<size_t>(capacity);
+    xs.resize(n);
+    ys.resize(n);
+    vxs.resize(n);
+    vys.resize(n);
+    ays.resize(n);
+    lives.resize(n);
+    kinds.resize(n);
+    buckets.resize(n);
+    rects.resize(n);
+}
+
+int ParticleSystem::spawn(const Emitter &emitter, int requested) {
+    const int n = std::min(requested, capacity() - count);
+    const int size = sizes[emitter.kind];
+    auto jitter = [this](qreal halfWidth) { return static_cast<float>((rng.generateDouble() * 2.0 - 1.0) * halfWidth); };
+    for (int i = count; i < count + n; ++i) {
+        const auto k = static_cast<size_t>(i);
+        xs[k] = static_cast<float>(emitter.origin.x()) + jitter(emitter.spread.x());
+        ys[k] = static_cast<float>(emitter.origin.y()) + jitter(emitter.spread.y());
+        vxs[k] = static_cast<float>(emitter.velocity.x()) + jitter(emitter.velocityJitter.x());
+        vys[k] = static_cast<float>(emitter.velocity.y()) + jitter(emitter.velocityJitter.y());
+        ays[k] = emitter.gravity;
+        lives[k] = emitter.life + jitter(emitter.lifeJitter);
+        kinds[k] = emitter.kind;
+        box |= QRect(qFloor(xs[k]), qFloor(ys[k]), size, size);
+    }
+    count += n;
+    return n;
+}
+
+/**
+ * 两遍：第一遍对 [0, count) 逐元素积分，落地用选择而不是分支，整段可向量化；
+ * 第二遍把仍存活且未飞出左右边界的粒子压实到前部，顺带求包围盒。
+ */
+void ParticleSystem::update(float dt) {
+    constexpr float floorY = static_cast<float>(GameConfig::groundY - sizes[KindDebris]); // rest on the track
+    const int n = count;
+    float *x = xs.data();
+    float *y = ys.data();
+    float *vx = vxs.data();
+    float *vy = vys.data();
+    const float *ay = ays.data();
+    float *life = lives.data();
+    for (int i = 0; i < n; ++i) {
+        vy[i] += ay[i] * dt;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        life[i] -= dt;
+        const bool grounded = y[i] >= floorY;
+        y[i] = grounded ? floorY : y[i];
+        vx[i] = grounded ? 0.0f : vx[i];
+        vy[i] = grounded ? 0.0f : vy[i];
+    }
+
+    constexpr float maxSize = static_cast<float>(*std::max_element(sizes.begin(), sizes.end()));
+    float minX = 0.0f;
+    float minY = 0.0f;
+    float maxX = 0.0f;
+    float maxY = 0.0f;
+    int live = 0;
+    for (int i = 0; i < n; ++i) {
+        if (life[i] <= 0.0f || x[i] < -maxSize || x[i] > GameConfig::windowWidth) {
+            continue;
+        }
+        if (live != i) {
+            const auto from = static_cast<size_t>(i);
+            const auto to = static_cast<size_t>(live);
+            xs[to] = xs[from];
+            ys[to] = ys[from];
+            vxs[to] = vxs[from];
+            vys[to] = vys[from];
+            ays[to] = ays[from];
+            lives[to] = lives[from];
+            kinds[to] = kinds[from];
+        }
+        minX = live == 0 ? x[i] : std::min(minX, x[i]);
+        minY = live == 0 ? y[i] : std::min(minY, y[i]);
+        maxX = live == 0 ? x[i] : std::max(maxX, x[i]);
+        maxY = live == 0 ? y[i] : std::max(maxY, y[i]);
+        ++live;
+    }
+    count = live;
+    box = live == 0 ? QRect()
+                    : QRect(QPoint(qFloor(minX), qFloor(minY)),
+                            QPoint(qFloor(maxX) + static_cast<int>(maxSize) - 1, qFloor(maxY) + static_cast<int>(maxSize) - 1));
+}
+
+void ParticleSystem::clear() {
+    count = 0;
+    box = QRect();
+}
+
+/**
+ * 计数排序分桶：先数各桶粒子数得到起点，再把方块写入各自的连续段，
+ * 每个非空桶设置一次画刷后用一次 drawRects 提交（最多 KindCount × 级别数 次）。
+ */
+void ParticleSystem::draw(QPainter &painter, const std::array<QColor, KindCount> &colors) {
+    if (count == 0) {
+        return;
+    }
+    constexpr int levels = GameConfig::particleOpacityLevels;
+    constexpr float levelScale = levels / GameConfig::particleFadeSeconds;
+    std::array<int, bucketCount> counts{};
+    for (int i = 0; i < count; ++i) {
+        const auto k = static_cast<size_t>(i);
+        const int level = std::min(levels - 1, static_cast<int>(lives[k] * levelScale));
+        buckets[k] = static_cast<quint8>(kinds[k] * levels + level);
+        ++counts[buckets[k]];
+    }
+    offsets[0] = 0;
+    for (int b = 0; b < bucketCount; ++b) {
+        offsets[static_cast<size_t>(b + 1)] = offsets[static_cast<size_t>(b)] + counts[static_cast<size_t>(b)];
+    }
+    std::array<int, bucketCount> next{};
+    std::copy(offsets.begin(), offsets.begin() + bucketCount, next.begin());
+    for (int i = 0; i < count; ++i) {
+        const auto k = static_cast<size_t>(i);
+        const int size = sizes[kinds[k]];
+        rects[static_cast<size_t>(next[buckets[k]]++)] = QRect(qFloor(xs[k]), qFloor(ys[k]), size, size);
+    }
+
+    painter.save();
+    painter.setPen(Qt::NoPen);
+    for (int b = 0; b < bucketCount; ++b) {
+        const int n = counts[static_cast<size_t>(b)];
+        if (n == 0) {
+            continue;
+        }
+        QColor color = colors[static_cast<size_t>(b / levels)];
+        color.setAlpha(color.alpha() * (b % levels + 1) / levels);
+        painter.setBrush(color);
+        painter.drawRects(rects.data() + offsets[static_cast<size_t>(b)], n);
+    }
+    painter.restore();
+}
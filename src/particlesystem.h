@@ -0,0 +1,98 @@
+#ifndef PARTICLESYSTEM_H
+#define PARTICLESYSTEM_H
+
+#include <QColor>
+#include <QPointF>
+#include <QRect>
+#include <QRandomGenerator>
+#include <array>
+#include <vector>
+#include "gameconfig.h"
+
+class QPainter;
+
+/**
+ * 粒子池：奔跑扬尘、落地尘土与撞击碎屑等纯视觉效果。
+ * 位置、速度、加速度、剩余寿命与种类分别存放在启动时一次分配好的连续数组中（SoA），
+ * 存活粒子始终紧凑排在 [0, size())。update() 先对整段数组做无分支积分（便于编译器向量化），
+ * 再一遍压实剔除死亡粒子；绘制按“种类 × 不透明度级别”分桶，每桶一次 drawRects，
+ * 状态切换次数与粒子数无关。不参与模拟，不影响确定性。
+ */
+class ParticleSystem {
+public:
+    enum Kind : quint8 {
+        KindDust = 0, // 尘土（浅色、小、几乎不受重力）
+        KindDebris,   // 碎屑（深色、稍大、受重力、落地停住）
+        KindCount
+    };
+
+    /** 一次发射的参数：各量在 ± 抖动范围内均匀随机。 */
+    struct Emitter {
+        QPointF origin;          // 发射中心（像素）
+        QPointF spread;          // 位置抖动半宽
+        QPointF velocity;        // 平均速度（像素/秒）
+        QPointF velocityJitter;  // 速度抖动半宽
+        float life = 0.5f;       // 平均寿命（秒）
+        float lifeJitter = 0.0f; // 寿命抖动半宽
+        float gravity = 0.0f;    // 竖直加速度（像素/秒²）
+        Kind kind = KindDust;
+    };
+
+    /**
+     * 预分配粒子池。
+     * @param capacity 最多同时存活的粒子数。
+     */
+    explicit ParticleSystem(int capacity = GameConfig::particleCapacity);
+
+    /**
+     * 发射 count 个粒子；池满时只发射放得下的部分。
+     * @return 实际发射数。
+     */
+    int spawn(const Emitter &emitter, int count);
+
+    /**
+     * 推进 dt 秒：积分、落地、剔除寿命耗尽的粒子，并重算包围盒。
+     * @param dt 时间步长（秒）。
+     */
+    void update(float dt);
+
+    /** 清空全部粒子（不释放内存）。 */
+    void clear();
+
+    /**
+     * 绘制全部存活粒子（实心方块，寿命末段按级别淡出）。
+     * @param painter 目标画家。
+     * @param colors 各种类的颜色（调用方按昼夜配色换算）。
+     */
+    void draw(QPainter &painter, const std::array<QColor, KindCount> &colors);
+
+    /** 存活粒子覆盖的屏幕区域（含方块尺寸），没有粒子时为空矩形。 */
+    [[nodiscard]] QRect bounds() const { return box; }
+
+    [[nodiscard]] int size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] int capacity() const { return static_cast<int>(xs.size()); }
+
+    /** 各种类方块边长（像素）。 */
+    static constexpr std::array<int, KindCount> sizes = {2, 3};
+private:
+    static constexpr int bucketCount = KindCount * GameConfig::particleOpacityLevels;
+
+    std::vector<float> xs;    // 左上角 X
+    std::vector<float> ys;    // 左上角 Y
+    std::vector<float> vxs;   // 水平速度
+    std::vector<float> vys;   // 竖直速度
+    std::vector<float> ays;   // 竖直加速度
+    std::vector<float> lives; // 剩余寿命（秒）
+    std::vector<quint8> kinds; // 种类
+    int count = 0;            // 存活粒子数
+    QRect box;                // 存活粒子包围盒
+
+    // draw() scratch, sized with the pool
+    std::vector<quint8> buckets;               // 每个粒子的桶号（种类 × 级别数 + 级别）
+    std::vector<QRect> rects;                  // 按桶分段的方块
+    std::array<int, bucketCount + 1> offsets{}; // 各桶在 rects 中的起点
+    QRandomGenerator rng;                      // 发射抖动（与世界的随机序列无关）
+};
+
+#endif // PARTICLESYSTEM_H
@@ -0,0 +1,358 @@
+#include "population.h"
+#include "gameconfig.h"
+#include "sweptaabb.h"
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+namespace {
+constexpr int chunkAlign = 64; // 段边界对齐到 64 个个体，相邻段不共享缓存行
+constexpr float distanceScale = 1.0f / GameConfig::windowWidth;
+constexpr float heightScale = 1.0f / 100.0f;
+constexpr float speedScale = 1.0f / 16.0f;
+
+/** 个体的碰撞矩形，与 Dino::boundingRect 一致。 */
+QRect agentBox(int y, bool down) {
+    return {GameConfig::dinoX + GameConfig::collisionInsetX,
+            y + GameConfig::collisionInsetY + (down ? GameConfig::dinoDuckYOffset : 0),
+            GameConfig::dinoWidth - 2 * GameConfig::collisionInsetX,
+            (down ? GameConfig::dinoDuckHeight : GameConfig::dinoHeight) - 2 * GameConfig::collisionInsetY};
+}
+}
+
+/**
+ * 构造：分配全部 SoA 数组，权重在 [-1, 1] 内均匀随机。
+ */
+Population::Population(int size, quint32 seed, std::shared_ptr<const SpriteCache> sharedSprites)
+    : count(std::max(size, 1)), rng(seed), sprites(std::move(sharedSprites)) {
+    const size_t n = static_cast<size_t>(count);
+    ys.assign(n, GameConfig::dinoGroundY);
+    vys.assign(n, 0);
+    jumping.assign(n, 0);
+    ducking.assign(n, 0);
+    prevYs.assign(n, GameConfig::dinoGroundY);
+    prevJumping.assign(n, 0);
+    prevDucking.assign(n, 0);
+    alive.assign(n, 1);
+    touching.assign(n, 0);
+    fitness.assign(n, 0);
+    jumpScore.assign(n, 0.0f);
+    duckScore.assign(n, 0.0f);
+    weights.resize(n * weightCount);
+    for (float &w : weights) {
+        w = static_cast<float>(rng.generateDouble() * 2.0 - 1.0);
+    }
+}
+
+Population::~Population() = default;
+
+/**
+ * 并行评估：按线程数切段（段长对齐到 chunkAlign），每段一个任务、一个世界。
+ * 所有世界使用同一种子，障碍流逐帧一致，段与段之间只在结束时汇合。
+ */
+Population::Generation Population::evaluate(quint32 courseSeed, int maxFrames, QThreadPool &pool) {
+    QElapsedTimer clock;
+    clock.start();
+
+    const int threads = std::max(pool.maxThreadCount(), 1);
+    int chunk = (count + threads - 1) / threads;
+    chunk = (chunk + chunkAlign - 1) / chunkAlign * chunkAlign;
+    const int chunks = (count + chunk - 1) / chunk;
+    while (static_cast<int>(worlds.size()) < chunks) {
+        auto world = std::make_unique<GameWorld>(sprites);
+        world->setDinoCollision(false);
+        worlds.push_back(std::move(world));
+    }
+    for (int c = 0; c < chunks; ++c) {
+        const int first = c * chunk;
+        const int last = std::min(first + chunk, count);
+        GameWorld *world = worlds[static_cast<size_t>(c)].get();
+        pool.start([this, world, first, last, courseSeed, maxFrames] {
+            run(*world, first, last, courseSeed, maxFrames);
+        });
+    }
+    pool.waitForDone();
+
+    Generation result;
+    result.index = generation;
+    qint64 total = 0;
+    for (int f : fitness) {
+        result.best = std::max(result.best, f);
+        total += f;
+    }
+    result.agentSteps = total;
+    result.mean = double(total) / count;
+    result.elapsedNs = clock.nsecsElapsed();
+    return result;
+}
+
+void Population::run(GameWorld &world, int first, int last, quint32 courseSeed, int maxFrames) {
+    world.reset(courseSeed);
+    world.start();
+    begin(first, last);
+    int survivors = last - first;
+    while (survivors > 0 && world.getFrameCount() < maxFrames) {
+        survivors = step(world, first, last);
+    }
+    // still alive at the frame cap
+    for (int i = first; i < last; ++i) {
+        if (alive[i]) {
+            fitness[i] = world.getFrameCount();
+        }
+    }
+}
+
+void Population::begin(int first, int last) {
+    std::fill(ys.begin() + first, ys.begin() + last, GameConfig::dinoGroundY);
+    std::fill(vys.begin() + first, vys.begin() + last, 0);
+    std::fill(jumping.begin() + first, jumping.begin() + last, 0);
+    std::fill(ducking.begin() + first, ducking.begin() + last, 0);
+    std::fill(alive.begin() + first, alive.begin() + last, 1);
+    std::fill(fitness.begin() + first, fitness.begin() + last, 0);
+}
+
+/**
+ * 推进一帧，顺序与 GameWorld::step() 对玩家恐龙的处理一致：
+ * 先按当前障碍决定输入，障碍前进，再更新恐龙物理，最后碰撞。
+ * 决策与物理对段内个体逐元素计算（死亡个体照算但被 alive 屏蔽），
+ * 碰撞与 GameWorld::checkCollision 相同地做扫掠判定：先对本步扫过恐龙 x 范围的障碍
+ * 做纵向区间粗判（取步初与步末包围盒的并），命中者再用 SweptAabb 求相交时间区间并沿区间采样掩码。
+ */
+int Population::step(GameWorld &world, int first, int last) {
+    // shared sensors: the nearest obstacle not yet passed (every agent has the same x)
+    const int dinoLeft = GameConfig::dinoX + GameConfig::collisionInsetX;
+    const int dinoRight = GameConfig::dinoX + GameConfig::dinoWidth - GameConfig::collisionInsetX - 1;
+    const int groundBase = GameConfig::groundY + GameConfig::groundAlignOffset;
+    std::array<float, sharedInputs> in = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+    const ObstacleStore &obstacles = world.getObstacles();
+    for (int j = 0; j < obstacles.size(); ++j) {
+        if (obstacles.x(j) + obstacles.width(j) <= dinoLeft) {
+            continue; // already passed
+        }
+        in[0] = (obstacles.x(j) - dinoRight) * distanceScale;
+        in[1] = obstacles.width(j) * heightScale;
+        in[2] = (groundBase - obstacles.y(j) - obstacles.height(j)) * heightScale;
+        in[3] = (groundBase - obstacles.y(j)) * heightScale;
+        break;
+    }
+    in[4] = world.getSpeed() * speedScale;
+
+    // decide: two dot products per agent, accumulated one weight row at a time
+    float *jump = jumpScore.data();
+    float *duck = duckScore.data();
+    std::fill(jump + first, jump + last, 0.0f);
+    std::fill(duck + first, duck + last, 0.0f);
+    for (int k = 0; k < sharedInputs; ++k) {
+        const float *wj = weightRow(k);
+        const float *wd = weightRow(inputCount + k);
+        const float v = in[k];
+        for (int i = first; i < last; ++i) {
+            jump[i] += wj[i] * v;
+            duck[i] += wd[i] * v;
+        }
+    }
+    {
+        const float *wjh = weightRow(sharedInputs);
+        const float *wdh = weightRow(inputCount + sharedInputs);
+        const float *wjv = weightRow(sharedInputs + 1);
+        const float *wdv = weightRow(inputCount + sharedInputs + 1);
+        const int *y = ys.data();
+        const int *vy = vys.data();
+        for (int i = first; i < last; ++i) {
+            const float height = (GameConfig::dinoGroundY - y[i]) * heightScale;
+            const float velocity = vy[i] * speedScale;
+            jump[i] += wjh[i] * height + wjv[i] * velocity;
+            duck[i] += wdh[i] * height + wdv[i] * velocity;
+        }
+    }
+
+    world.step(InputState());
+
+    // physics (Dino::jump / setDucking / update), branch-free
+    {
+        int *y = ys.data();
+        int *vy = vys.data();
+        quint8 *air = jumping.data();
+        quint8 *down = ducking.data();
+        const quint8 *live = alive.data();
+        int *prevY = prevYs.data();
+        quint8 *prevAir = prevJumping.data();
+        quint8 *prevDown = prevDucking.data();
+        for (int i = first; i < last; ++i) {
+            prevY[i] = y[i];
+            prevAir[i] = air[i];
+            prevDown[i] = down[i];
+            const quint8 start = live[i] & quint8(jump[i] > 0.0f) & quint8(air[i] ^ 1);
+            down[i] = live[i] ? quint8(duck[i] > 0.0f) : down[i];
+            vy[i] = start ? GameConfig::dinoJumpSpeed : vy[i];
+            const quint8 a = air[i] | start;
+            y[i] += a ? vy[i] : 0;
+            vy[i] += a ? GameConfig::dinoGravity : 0;
+            const quint8 landed = a & quint8(y[i] >= GameConfig::dinoGroundY);
+            y[i] = landed ? GameConfig::dinoGroundY : y[i];
+            vy[i] = landed ? 0 : vy[i];
+            air[i] = a & quint8(landed ^ 1);
+        }
+    }
+
+    // broad phase: obstacles whose swept span this step overlaps the shared x span,
+    // then a vertical interval test per agent against the union of its start and end boxes
+    const int speed = world.getSpeed();
+    std::array<int, ObstacleStore::capacity> nearby;
+    int nearCount = 0;
+    for (int j = 0; j < obstacles.size(); ++j) {
+        if (obstacles.x(j) > dinoRight) {
+            break; // sorted by x
+        }
+        if (obstacles.x(j) + obstacles.width(j) + speed > dinoLeft) {
+            nearby[nearCount++] = j;
+        }
+    }
+    int survivors = 0;
+    if (nearCount == 0) {
+        for (int i = first; i < last; ++i) {
+            survivors += alive[i];
+        }
+        return survivors;
+    }
+    {
+        const int *y = ys.data();
+        const quint8 *down = ducking.data();
+        const int *prevY = prevYs.data();
+        const quint8 *prevDown = prevDucking.data();
+        const quint8 *live = alive.data();
+        quint8 *touch = touching.data();
+        std::fill(touch + first, touch + last, 0);
+        for (int n = 0; n < nearCount; ++n) {
+            const int obstacleTop = obstacles.y(nearby[n]);
+            const int obstacleBottom = obstacleTop + obstacles.height(nearby[n]);
+            for (int i = first; i < last; ++i) {
+                const int top = std::min(y[i] + (down[i] ? GameConfig::dinoDuckYOffset : 0),
+                                         prevY[i] + (prevDown[i] ? GameConfig::dinoDuckYOffset : 0))
+                    + GameConfig::collisionInsetY;
+                const int bottom = std::max(y[i] + (down[i] ? GameConfig::dinoDuckYOffset + GameConfig::dinoDuckHeight : GameConfig::dinoHeight),
+                                            prevY[i] + (prevDown[i] ? GameConfig::dinoDuckYOffset + GameConfig::dinoDuckHeight : GameConfig::dinoHeight))
+                    - GameConfig::collisionInsetY;
+                touch[i] |= live[i] & quint8(top < obstacleBottom) & quint8(bottom > obstacleTop);
+            }
+        }
+    }
+
+    // narrow phase: only agents whose box touched something
+    const int frameCount = world.getFrameCount();
+    const bool toggle = (frameCount / GameConfig::dinoAnimationFrames) & 1;
+    for (int i = first; i < last; ++i) {
+        if (!touching[i]) {
+            survivors += alive[i];
+            continue;
+        }
+        Dino::Frame frame = toggle ? Dino::FrameRun2 : Dino::FrameRun1;
+        int drawY = ys[i];
+        if (jumping[i]) {
+            frame = Dino::FrameJump;
+        }
+        else if (ducking[i]) {
+            frame = toggle ? Dino::FrameDuck2 : Dino::FrameDuck1;
+            drawY += GameConfig::dinoDuckYOffset;
+        }
+        const CollisionMask &dinoMask = sprites->entry(sprites->dino(frame)).mask;
+        const int prevDrawY = prevYs[i] + (prevDucking[i] && !prevJumping[i] ? GameConfig::dinoDuckYOffset : 0);
+        const QRect box = agentBox(ys[i], ducking[i]);
+        const QRect prevBox = agentBox(prevYs[i], prevDucking[i]);
+        bool hit = false;
+        for (int n = 0; n < nearCount && !hit; ++n) {
+            // same sweep and sampling as GameWorld::checkCollision, so fitness counts exactly the game's hits
+            const QRect obstacleRect = obstacles.rect(nearby[n]);
+            double enter = 0.0;
+            double exit = 0.0;
+            if (!SweptAabb::overlapInterval(prevBox, box, obstacleRect.translated(speed, 0), obstacleRect, enter, exit)) {
+                continue;
+            }
+            const CollisionMask &obstacleMask = sprites->entry(sprites->animated(obstacles.sprite(nearby[n]), frameCount)).mask;
+            hit = !GameConfig::pixelPerfectCollision || dinoMask.isNull() || obstacleMask.isNull();
+            if (!hit) {
+                const double travel = (exit - enter) * std::max(speed, std::abs(drawY - prevDrawY));
+                const int samples = static_cast<int>(std::ceil(travel / GameConfig::sweepSampleSpacing));
+                for (int k = 0; k <= samples && !hit; ++k) {
+                    const double t = samples == 0 ? exit : enter + (exit - enter) * k / samples;
+                    const QPoint dinoPos(GameConfig::dinoX, prevDrawY + qRound((drawY - prevDrawY) * t));
+                    const QPoint obstaclePos(obstacleRect.x() + qRound(speed * (1.0 - t)), obstacleRect.y());
+                    hit = CollisionMask::overlaps(dinoMask, dinoPos, obstacleMask, obstaclePos);
+                }
+            }
+        }
+        if (hit) {
+            alive[i] = 0;
+            fitness[i] = frameCount;
+        }
+        else {
+            ++survivors;
+        }
+    }
+    return survivors;
+}
+
+/**
+ * 繁殖：按得分降序排名（同分按编号），前 trainEliteFraction 原样保留，
+ * 其余个体从前 trainParentFraction 中随机挑父代，每个权重加 [-scale, scale] 的均匀扰动。
+ */
+void Population::evolve() {
+    std::vector<int> order(static_cast<size_t>(count));
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) { return fitness[a] > fitness[b]; });
+
+    const int elites = std::max(1, static_cast<int>(count * GameConfig::trainEliteFraction));
+    const int parents = std::max(1, static_cast<int>(count * GameConfig::trainParentFraction));
+    std::vector<int> source(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        source[i] = i < elites ? order[i] : order[rng.bounded(parents)];
+    }
+
+    std::vector<float> next(weights.size());
+    for (int k = 0; k < weightCount; ++k) {
+        const float *from = weightRow(k);
+        float *to = next.data() + static_cast<size_t>(k) * count;
+        for (int i = 0; i < count; ++i) {
+            float w = from[source[i]];
+            if (i >= elites) {
+                w += static_cast<float>((rng.generateDouble() * 2.0 - 1.0) * GameConfig::trainMutationScale);
+            }
+            to[i] = w;
+        }
+    }
+    weights = std::move(next);
+    ++generation;
+}
+
+/**
+ * 半透明叠加：存活个体按（贴图，高度）去重，数千个体通常只剩几十个不同姿态。
+ */
+void Population::ghosts(const GameWorld &world, WorldSnapshot &out) const {
+    out.ghosts.clear();
+    const bool toggle = (world.getFrameCount() / GameConfig::dinoAnimationFrames) & 1;
+    for (int i = 0; i < count; ++i) {
+        if (!alive[i]) {
+            continue;
+        }
+        Dino::Frame frame = toggle ? Dino::FrameRun2 : Dino::FrameRun1;
+        int y = ys[i];
+        if (jumping[i]) {
+            frame = Dino::FrameJump;
+        }
+        else if (ducking[i]) {
+            frame = toggle ? Dino::FrameDuck2 : Dino::FrameDuck1;
+            y += GameConfig::dinoDuckYOffset;
+        }
+        out.ghosts.push_back({sprites->dino(frame), GameConfig::dinoX, y});
+    }
+    const auto key = [](const WorldSnapshot::Sprite &s) { return std::make_pair(s.sprite, s.y); };
+    std::sort(out.ghosts.begin(), out.ghosts.end(),
+              [&key](const WorldSnapshot::Sprite &a, const WorldSnapshot::Sprite &b) { return key(a) < key(b); });
+    out.ghosts.erase(std::unique(out.ghosts.begin(), out.ghosts.end(),
+                                 [&key](const WorldSnapshot::Sprite &a, const WorldSnapshot::Sprite &b) { return key(a) == key(b); }),
+                     out.ghosts.end());
+}
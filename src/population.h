@@ -0,0 +1,116 @@
+#ifndef POPULATION_H
+#define POPULATION_H
+
+#include <QRandomGenerator>
+#include <QtGlobal>
+#include <memory>
+#include <vector>
+#include "gameworld.h"
+#include "spritecache.h"
+#include "worldsnapshot.h"
+
+class QThreadPool;
+
+/**
+ * 神经进化训练用的恐龙种群：成千上万个个体跑同一条障碍流。
+ * 个体状态（y、vy、跳跃、下蹲、存活、得分）与网络权重全部按结构体数组（SoA）存放，
+ * 每帧的决策、物理与碰撞粗判都是对连续数组的无分支循环，便于编译器向量化；
+ * 只有粗判命中的少数个体再逐个做掩码判定。
+ *
+ * 每个个体是一个单层感知机：inputCount 个输入（前方障碍距离/尺寸、速度、自身高度与速度、偏置）
+ * 线性组合后分别决定是否起跳、是否下蹲。权重按“权重编号优先”排列，
+ * 即第 k 个权重的全体个体值连续存放。
+ *
+ * evaluate() 把种群切成若干段在线程池中并行评估：每段各持有一个关闭了自身碰撞的 GameWorld，
+ * 使用同一种子，因此各段看到的障碍流完全相同，线程之间无需逐帧同步。
+ */
+class Population {
+public:
+    static constexpr int sharedInputs = 6;                      // 全体共享的输入：距离、宽、底高、顶高、速度、偏置
+    static constexpr int agentInputs = 2;                       // 个体自身输入：离地高度、垂直速度
+    static constexpr int inputCount = sharedInputs + agentInputs;
+    static constexpr int weightCount = inputCount * 2;          // 起跳与下蹲各一组
+
+    /** 一代的评估结果。 */
+    struct Generation {
+        int index = 0;        // 代数（从 0 开始）
+        int best = 0;         // 最长存活帧数
+        double mean = 0;      // 平均存活帧数
+        qint64 agentSteps = 0; // 本代全体个体累计模拟帧数
+        qint64 elapsedNs = 0; // 评估耗时（纳秒）
+    };
+
+    /**
+     * 构造种群并随机初始化权重。
+     * @param size 个体数。
+     * @param seed 权重初始化与变异的随机种子。
+     * @param sharedSprites 共享的预缩放贴图缓存（各评估世界与掩码判定共用）。
+     */
+    Population(int size, quint32 seed, std::shared_ptr<const SpriteCache> sharedSprites);
+    ~Population();
+
+    [[nodiscard]] int size() const { return count; }
+    [[nodiscard]] int getGeneration() const { return generation; }
+    [[nodiscard]] int getFitness(int i) const { return fitness[static_cast<size_t>(i)]; }
+
+    /**
+     * 在指定种子的赛道上评估全体个体，直到全部死亡或达到帧数上限。
+     * @param courseSeed 赛道（GameWorld）种子。
+     * @param maxFrames 帧数上限。
+     * @param pool 执行各段评估的线程池。
+     */
+    Generation evaluate(quint32 courseSeed, int maxFrames, QThreadPool &pool);
+
+    /**
+     * 按上一次 evaluate() 的得分繁殖下一代：精英原样保留，其余由前列个体变异得到。
+     */
+    void evolve();
+
+    /**
+     * 把 [first, last) 段的个体放回地面并标记为存活（开始新一局前调用）。
+     */
+    void begin(int first, int last);
+
+    /**
+     * 推进一帧：段内个体按当前障碍做决策，world 前进一步，再更新个体物理并判定碰撞。
+     * world 应已 setDinoCollision(false) 并 start()。
+     * @return 段内仍存活的个体数。
+     */
+    int step(GameWorld &world, int first, int last);
+
+    /**
+     * 把存活个体作为半透明叠加写入快照；同一贴图同一高度的个体只保留一份。
+     * @param world 个体所在的世界（提供帧时钟）。
+     * @param out 输出快照（覆盖其中的 ghosts）。
+     */
+    void ghosts(const GameWorld &world, WorldSnapshot &out) const;
+private:
+    /** 在 world 上完整评估 [first, last) 段（线程池任务）。 */
+    void run(GameWorld &world, int first, int last, quint32 courseSeed, int maxFrames);
+
+    /** 第 k 个权重的全体个体值。 */
+    [[nodiscard]] float *weightRow(int k) { return weights.data() + static_cast<size_t>(k) * count; }
+
+    int count;
+    int generation = 0;
+    QRandomGenerator rng; // 初始化与变异
+    std::shared_ptr<const SpriteCache> sprites;
+    std::vector<std::unique_ptr<GameWorld>> worlds; // 每个并行段一个，跨代复用
+
+    // agent state (SoA)
+    std::vector<int> ys;          // 左上角 Y
+    std::vector<int> vys;         // 垂直速度
+    std::vector<quint8> jumping;  // 是否在空中
+    std::vector<quint8> ducking;  // 是否下蹲
+    std::vector<int> prevYs;          // 本步开始时的 Y（扫掠判定）
+    std::vector<quint8> prevJumping;  // 本步开始时是否在空中
+    std::vector<quint8> prevDucking;  // 本步开始时是否下蹲
+    std::vector<quint8> alive;    // 是否存活
+    std::vector<quint8> touching; // 本帧粗判命中（待掩码判定）
+    std::vector<int> fitness;     // 存活帧数
+    std::vector<float> jumpScore; // 本帧起跳输出
+    std::vector<float> duckScore; // 本帧下蹲输出
+    std::vector<float> weights;   // weightCount 行 × count 列
+};
+
+#endif // POPULATION_H
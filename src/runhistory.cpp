@@ -0,0 +1,123 @@
+#include "runhistory.h"
+#include <QString>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr char magic[4] = {'D', 'R', 'U', 'N'};
+constexpr quint16 version = 1;
+constexpr qint64 headerSize = 16;
+constexpr qint64 entrySize = 16;
+constexpr int initialCapacity = 4096; // 首次创建时预留的条数
+constexpr qint64 countOffset = 8;     // 文件头中条数字段的偏移
+
+void put16(uchar *p, quint16 v) {
+    p[0] = static_cast<uchar>(v);
+    p[1] = static_cast<uchar>(v >> 8);
+}
+
+void put32(uchar *p, quint32 v) {
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<uchar>(v >> (8 * i));
+    }
+}
+
+quint16 get16(const uchar *p) {
+    return static_cast<quint16>(p[0] | (p[1] << 8));
+}
+
+quint32 get32(const uchar *p) {
+    return quint32(p[0]) | quint32(p[1]) << 8 | quint32(p[2]) << 16 | quint32(p[3]) << 24;
+}
+
+} // namespace
+
+RunHistory::~RunHistory() {
+    close();
+}
+
+/**
+ * 打开：文件头合法时沿用其中的条数（不超过文件实际容量），否则截断重建。
+ */
+bool RunHistory::open(const QString &path) {
+    close();
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+    const qint64 bytes = file.size();
+    int existing = bytes >= headerSize ? static_cast<int>((bytes - headerSize) / entrySize) : 0;
+    if (!reserve(std::max(existing, initialCapacity))) {
+        close();
+        return false;
+    }
+
+    const bool valid = bytes >= headerSize && std::memcmp(map, magic, sizeof(magic)) == 0
+        && get16(map + 4) == version && get16(map + 6) == entrySize;
+    if (valid) {
+        count = static_cast<int>(std::min<quint32>(get32(map + countOffset), static_cast<quint32>(existing)));
+    }
+    else {
+        // new or unreadable: start over
+        std::memset(map, 0, headerSize);
+        std::memcpy(map, magic, sizeof(magic));
+        put16(map + 4, version);
+        put16(map + 6, entrySize);
+        count = 0;
+    }
+    put32(map + countOffset, static_cast<quint32>(count));
+    return true;
+}
+
+void RunHistory::close() {
+    if (map) {
+        file.unmap(map);
+        map = nullptr;
+    }
+    if (file.isOpen()) {
+        file.close();
+    }
+    count = 0;
+    capacity = 0;
+}
+
+RunHistory::Entry RunHistory::at(int i) const {
+    const uchar *p = map + headerSize + i * entrySize;
+    Entry e;
+    e.score = get32(p);
+    e.frames = get32(p + 4);
+    e.seed = get32(p + 8);
+    e.cause = p[12];
+    return e;
+}
+
+bool RunHistory::append(const Entry &entry) {
+    if (!map || (count == capacity && !reserve(capacity * 2))) {
+        return false;
+    }
+    uchar *p = map + headerSize + count * entrySize;
+    put32(p, entry.score);
+    put32(p + 4, entry.frames);
+    put32(p + 8, entry.seed);
+    p[12] = entry.cause;
+    p[13] = p[14] = p[15] = 0;
+    // publish only after the record is complete
+    ++count;
+    put32(map + countOffset, static_cast<quint32>(count));
+    return true;
+}
+
+bool RunHistory::reserve(int entries) {
+    if (map) {
+        file.unmap(map);
+        map = nullptr;
+    }
+    const qint64 bytes = headerSize + entries * entrySize;
+    if (file.size() < bytes && !file.resize(bytes)) {
+        return false;
+    }
+    map = file.map(0, bytes);
+    capacity = map ? entries : 0;
+    return map != nullptr;
+}
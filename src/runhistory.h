@@ -0,0 +1,73 @@
+#ifndef RUNHISTORY_H
+#define RUNHISTORY_H
+
+#include <QFile>
+#include <QtGlobal>
+
+class QString;
+
+/**
+ * 跑局历史：只追加的定长记录文件，整体内存映射。
+ * 打开时只读 16 字节文件头并映射文件，不逐条解析，几十万条记录也能立即可用；
+ * 追加一条只是写入映射内存再更新文件头中的条数（先写记录后改条数，
+ * 中途崩溃最多丢失最后一条，不会读到半条记录）。文件按容量成倍预留，
+ * 映射用满时才扩容并重新映射（同步 I/O），因此游戏在后台写入线程上追加。
+ *
+ * 文件格式（小端）：
+ *   文件头："DRUN" 魔数 | u16 版本 | u16 记录长度 | u32 条数 | u32 保留
+ *   记录：u32 分数 | u32 帧数 | u32 种子 | u8 死因 | 3 字节填充
+ */
+class RunHistory {
+public:
+    /** 一条跑局记录。 */
+    struct Entry {
+        quint32 score = 0;  // 最终分数
+        quint32 frames = 0; // 存活帧数
+        quint32 seed = 0;   // 本局种子（可配合输入日志重放）
+        quint8 cause = 0;   // 死因（GameWorld::DeathCause）
+    };
+
+    RunHistory() = default;
+    ~RunHistory();
+
+    RunHistory(const RunHistory &) = delete;
+    RunHistory &operator=(const RunHistory &) = delete;
+
+    /**
+     * 打开（不存在时创建）历史文件并映射。文件头不合法时视为损坏，重新开始。
+     * @param path 文件路径。
+     * @return 成功返回 true；失败时 append() 静默忽略。
+     */
+    bool open(const QString &path);
+
+    /** 解除映射并关闭文件。 */
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return map != nullptr; }
+    [[nodiscard]] int size() const { return count; }
+
+    /**
+     * 读取第 i 条记录（0 为最早）。
+     * @param i 下标 [0, size())。
+     */
+    [[nodiscard]] Entry at(int i) const;
+
+    /**
+     * 追加一条记录（写入映射内存；容量用满时同步扩容文件并重新映射）。
+     * @return 未打开或扩容失败时返回 false。
+     */
+    bool append(const Entry &entry);
+private:
+    /**
+     * 把文件扩到能容纳 entries 条记录并重新映射。
+     * @param entries 目标容量（条）。
+     */
+    bool reserve(int entries);
+
+    QFile file;
+    uchar *map = nullptr; // 整个文件的映射
+    int count = 0;        // 已写入条数
+    int capacity = 0;     // 当前文件可容纳条数
+};
+
+#endif // RUNHISTORY_H
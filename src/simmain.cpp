@@ -0,0 +1,218 @@
+#include "autopilot.h"
+#include "gameworld.h"
+#include "gameconfig.h"
+#include "inputlog.h"
+#include "obstaclecourse.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <algorithm>
+
+namespace {
+
+/**
+ * 以最高速度重放录制的一局若干次，并校验死亡帧与分数与录制一致。
+ * 录制时载入了障碍赛道的日志先载入同一赛道。
+ * @param log 已加载的输入日志。
+ * @param repeat 重放次数。
+ * @param profiler 可选分析器。
+ * @param course 赛道文件，为空时使用日志中记录的赛道（文件被移动时用它指定）。
+ * @return 全部一致返回 0，否则返回 1。
+ */
+int replay(InputLog &log, qint64 repeat, FrameProfiler *profiler, const QString &course) {
+    GameWorld world;
+    world.setProfiler(profiler);
+    QTextStream out(stdout);
+    if (!log.isFinished()) {
+        out << "input log has no end record\n";
+        return 1;
+    }
+    const QString coursePath = course.isEmpty() ? log.getCourse() : course;
+    if (!world.loadCourse(coursePath)) {
+        out << "failed to read course file " << coursePath << '\n';
+        return 1;
+    }
+
+    qint64 frames = 0;
+    bool ok = true;
+    QElapsedTimer clock;
+    clock.start();
+    for (qint64 i = 0; i < repeat && ok; ++i) {
+        world.reset(log.getSeed());
+        world.start();
+        log.rewind();
+        // 上限防止日志与代码不一致时永不死亡
+        while (!world.gameOver() && static_cast<quint32>(world.getFrameCount()) <= log.getFinalFrame()) {
+            world.step(log.replay(static_cast<quint32>(world.getFrameCount())));
+        }
+        frames += world.getFrameCount();
+        ok = world.gameOver()
+            && static_cast<quint32>(world.getFrameCount()) == log.getFinalFrame()
+            && static_cast<quint32>(world.getScore()) == log.getFinalScore();
+    }
+    const qint64 elapsedNs = qMax<qint64>(clock.nsecsElapsed(), 1);
+
+    out << "seed: " << log.getSeed() << '\n';
+    if (world.hasCourse()) {
+        out << "course: " << coursePath << '\n';
+    }
+    out << "expected: frame " << log.getFinalFrame() << " score " << log.getFinalScore() << '\n';
+    out << "replayed: frame " << world.getFrameCount() << " score " << world.getScore()
+        << (world.gameOver() ? "" : " (still alive)") << '\n';
+    out << "frames: " << frames << '\n';
+    out << "elapsed ms: " << elapsedNs / 1000000.0 << '\n';
+    out << "frames/s: " << double(frames) * 1e9 / double(elapsedNs) << '\n';
+    out << (ok ? "PASS" : "FAIL: replay diverged from recording") << '\n';
+    return ok ? 0 : 1;
+}
+
+/**
+ * 导出赛道：关闭自身碰撞推进 frames 帧，把这一种子下随机生成的障碍序列写入赛道文件。
+ * @param path 输出文件。
+ * @param seeded 是否使用指定种子（否则随机选一个）。
+ * @param seed 随机种子（写入文件头）。
+ * @param frames 推进的帧数。
+ * @return 成功返回 0。
+ */
+int writeCourse(const QString &path, bool seeded, quint32 seed, qint64 frames) {
+    GameWorld world;
+    if (seeded) {
+        world.reset(seed);
+    }
+    else {
+        world.reset();
+    }
+    world.setDinoCollision(false);
+    ObstacleCourseWriter writer;
+    QTextStream out(stdout);
+    if (!writer.open(path, world.getSeed())) {
+        out << "failed to open course file\n";
+        return 1;
+    }
+    world.setCourseWriter(&writer);
+    world.start();
+    for (qint64 frame = 0; frame < frames; ++frame) {
+        world.step(InputState{});
+    }
+    world.setCourseWriter(nullptr);
+    if (!writer.finish()) {
+        out << "failed to write course file\n";
+        return 1;
+    }
+    out << "seed: " << world.getSeed() << '\n';
+    out << "frames: " << frames << '\n';
+    out << "obstacles: " << writer.size() << '\n';
+    return 0;
+}
+
+} // namespace
+
+/**
+ * 无头仿真入口：不创建窗口，尽可能快地推进 GameWorld，
+ * 用于压力测试与平衡性统计。死亡后自动重开。
+ * 指定 --replay 时改为重放录制的输入日志并校验结果（确定性回归）；
+ * --course 让自动驾驶跑赛道文件，--write-course 把种子对应的随机障碍序列导出为赛道文件。
+ */
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("dino_sim");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless DinoGame simulation");
+    parser.addHelpOption();
+    QCommandLineOption framesOption("frames", "Number of frames to simulate.", "n", "1000000");
+    parser.addOption(framesOption);
+    QCommandLineOption profileOutOption("profile-out", "Write per-phase step timings to a CSV file.", "file");
+    parser.addOption(profileOutOption);
+    QCommandLineOption seedOption("seed", "Seed of the first run; run k uses seed + k.", "n");
+    parser.addOption(seedOption);
+    QCommandLineOption replayOption("replay", "Replay a recorded input log and verify the final frame and score.", "file");
+    parser.addOption(replayOption);
+    QCommandLineOption repeatOption("repeat", "Number of times to replay the log.", "n", "1");
+    parser.addOption(repeatOption);
+    QCommandLineOption courseOption("course", "Spawn obstacles from a course file instead of at random "
+                                    "(with --replay: overrides the course recorded in the log).", "file");
+    parser.addOption(courseOption);
+    QCommandLineOption writeCourseOption("write-course", "Export the obstacles spawned over --frames with --seed to a course file.", "file");
+    parser.addOption(writeCourseOption);
+    parser.process(app);
+
+    const qint64 totalFrames = parser.value(framesOption).toLongLong();
+
+    FrameProfiler profiler;
+    FrameProfiler *activeProfiler = parser.isSet(profileOutOption) ? &profiler : nullptr;
+    const auto writeProfile = [&]() {
+        if (activeProfiler && !profiler.writeCsv(parser.value(profileOutOption))) {
+            QTextStream(stdout) << "failed to write profile\n";
+            return false;
+        }
+        return true;
+    };
+
+    if (parser.isSet(replayOption)) {
+        InputLog log;
+        if (!log.load(parser.value(replayOption))) {
+            QTextStream(stdout) << "failed to read input log\n";
+            return 1;
+        }
+        const int ret = replay(log, qMax<qint64>(parser.value(repeatOption).toLongLong(), 1), activeProfiler,
+                               parser.value(courseOption));
+        return writeProfile() ? ret : 1;
+    }
+
+    const bool seeded = parser.isSet(seedOption);
+    const quint32 firstSeed = parser.value(seedOption).toUInt();
+    if (parser.isSet(writeCourseOption)) {
+        return writeCourse(parser.value(writeCourseOption), seeded, firstSeed, totalFrames);
+    }
+
+    GameWorld world;
+    world.setProfiler(activeProfiler);
+    if (parser.isSet(courseOption) && !world.loadCourse(parser.value(courseOption))) {
+        QTextStream(stdout) << "failed to read course file\n";
+        return 1;
+    }
+    if (seeded) {
+        world.reset(firstSeed);
+    }
+    world.start();
+
+    qint64 runs = 0;
+    qint64 scoreSum = 0;
+    int dropped = 0; // course entries skipped / moved in a run (the same course every run)
+    int shifted = 0;
+    QElapsedTimer clock;
+    clock.start();
+    for (qint64 frame = 0; frame < totalFrames; ++frame) {
+        world.step(autopilot(world));
+        dropped = std::max(dropped, world.getDroppedSpawns());
+        shifted = std::max(shifted, world.getShiftedSpawns());
+        if (world.gameOver()) {
+            ++runs;
+            scoreSum += world.getScore();
+            if (seeded) {
+                world.reset(firstSeed + static_cast<quint32>(runs));
+            }
+            else {
+                world.reset();
+            }
+            world.start();
+        }
+    }
+    const qint64 elapsedNs = qMax<qint64>(clock.nsecsElapsed(), 1);
+
+    QTextStream out(stdout);
+    out << "frames: " << totalFrames << '\n';
+    out << "runs: " << runs << '\n';
+    out << "best score: " << world.getHighScore() << '\n';
+    out << "mean score: " << (runs > 0 ? double(scoreSum) / double(runs) : 0.0) << '\n';
+    if (world.hasCourse()) {
+        out << "course entries skipped (not clearable): " << dropped << '\n';
+        out << "course entries moved right (too close): " << shifted << '\n';
+    }
+    out << "elapsed ms: " << elapsedNs / 1000000.0 << '\n';
+    out << "frames/s: " << double(totalFrames) * 1e9 / double(elapsedNs) << '\n';
+
+    return writeProfile() ? 0 : 1;
+}
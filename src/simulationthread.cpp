@@ -0,0 +1,201 @@
+#include "simulationthread.h"
+#include "gameconfig.h"
+#include <QMutexLocker>
+#include <QThread>
+#include <QtGlobal>
+#include <algorithm>
+#include <utility>
+
+namespace {
+constexpr qint64 stepNs = 1000000000LL / GameConfig::simulationHz; // 固定模拟步长（纳秒）
+}
+
+/**
+ * 构造：世界在界面线程建好并发布一帧初始快照，界面在线程第一次步进前就有东西可画。
+ */
+SimulationThread::SimulationThread(FrameProfiler *profiler) {
+    clock.start();
+    world.setProfiler(profiler);
+    recording.begin(world.getSeed());
+    world.snapshot(current);
+    previous = current;
+    publish();
+    thread.reset(QThread::create([this] { run(); }));
+    thread->start(QThread::HighPriority);
+}
+
+SimulationThread::~SimulationThread() {
+    {
+        QMutexLocker locker(&mutex);
+        stopping = true;
+        wake.wakeOne();
+    }
+    thread->wait();
+}
+
+quint32 SimulationThread::start() {
+    QMutexLocker locker(&mutex);
+    return post(Command::Start, false, 0);
+}
+
+quint32 SimulationThread::reset(bool fixedSeed, quint32 value) {
+    QMutexLocker locker(&mutex);
+    return post(Command::Reset, fixedSeed, value);
+}
+
+quint32 SimulationThread::setHighScore(int value) {
+    QMutexLocker locker(&mutex);
+    return post(Command::HighScore, false, static_cast<quint32>(value));
+}
+
+void SimulationThread::setRecordPath(const QString &path) {
+    QMutexLocker locker(&mutex);
+    recordPath = path;
+}
+
+void SimulationThread::setCoursePath(const QString &path) {
+    QMutexLocker locker(&mutex);
+    coursePath = path;
+}
+
+void SimulationThread::push(quint64 eventMs, InputQueue::Kind kind) {
+    QMutexLocker locker(&mutex);
+    inputQueue.push(inputQueue.toClock(eventMs, clock.nsecsElapsed()), kind);
+}
+
+quint32 SimulationThread::post(Command::Type type, bool fixedSeed, quint32 value) {
+    commands.push_back({type, fixedSeed, value, ++issued});
+    wake.wakeOne();
+    return issued;
+}
+
+/**
+ * 主循环：未运行时睡到有命令为止；运行时睡到下一步的结束时刻。
+ * 第 k 步覆盖时钟区间 (stepEnd - 步长, stepEnd]，到期后在锁内取出该区间内的按键，
+ * 解锁后推进世界，整批步进完成后发布一次（界面只需要最新的前后两步）。
+ * 卡顿后最多追赶 maxCatchUpSteps 步，之前的时间直接丢弃。
+ */
+void SimulationThread::run() {
+    std::array<InputState, GameConfig::maxCatchUpSteps> inputs;
+    std::array<qint64, GameConfig::maxCatchUpSteps> inputTimes;
+    QMutexLocker locker(&mutex);
+    for (;;) {
+        while (commands.empty() && !stopping) {
+            if (!world.running()) {
+                wake.wait(&mutex);
+                continue;
+            }
+            const qint64 waitNs = nextStepEndNs - clock.nsecsElapsed();
+            if (waitNs <= 0) {
+                break;
+            }
+            wake.wait(&mutex, static_cast<unsigned long>((waitNs + 999999) / 1000000));
+        }
+        if (stopping) {
+            break;
+        }
+
+        if (!commands.empty()) {
+            for (const Command &command : commands) {
+                apply(command);
+            }
+            commands.clear();
+            // the world changed outside step(): both snapshots equal the new state
+            world.snapshot(current);
+            previous = current;
+            stepEndNs = clock.nsecsElapsed();
+            nextStepEndNs = stepEndNs + stepNs; // time before a start is not simulated
+            publish();
+            continue;
+        }
+
+        // clamp after a long stall so we do not spiral
+        const qint64 now = clock.nsecsElapsed();
+        nextStepEndNs = std::max(nextStepEndNs, now - stepNs * (GameConfig::maxCatchUpSteps - 1));
+        int due = 0;
+        while (due < GameConfig::maxCatchUpSteps && nextStepEndNs + due * stepNs <= now) {
+            inputTimes[static_cast<size_t>(due)] = -1;
+            inputs[static_cast<size_t>(due)] = inputQueue.take(nextStepEndNs + due * stepNs, &inputTimes[static_cast<size_t>(due)]);
+            ++due;
+        }
+        const QString path = recordPath;
+        locker.unlock();
+
+        for (int k = 0; k < due; ++k) {
+            const InputState &input = inputs[static_cast<size_t>(k)];
+            const qint64 inputTime = inputTimes[static_cast<size_t>(k)];
+            std::swap(previous, current);
+            if (world.running()) {
+                recording.record(static_cast<quint32>(world.getFrameCount()), input);
+                if (inputTime >= 0) {
+                    inputNs[inputCount % SimFrame::recentInputs] = inputTime;
+                    ++inputCount;
+                }
+            }
+            world.step(input);
+            world.snapshot(current);
+            stepEndNs = nextStepEndNs;
+            nextStepEndNs += stepNs;
+            if (world.gameOver() && !recording.isFinished()) {
+                recording.finish(static_cast<quint32>(world.getFrameCount()), static_cast<quint32>(world.getScore()));
+                if (!path.isEmpty() && !recording.save(path)) {
+                    qWarning("Failed to write input log to %s", qPrintable(path));
+                }
+                if (world.getDroppedSpawns() > 0 || world.getShiftedSpawns() > 0) {
+                    qWarning("Obstacle course %s: %d entries could not be cleared and were skipped, %d were moved right to keep them clearable",
+                             qPrintable(loadedCourse), world.getDroppedSpawns(), world.getShiftedSpawns());
+                }
+                break; // nothing moves after game over
+            }
+        }
+        if (due > 0) {
+            publish();
+        }
+        locker.relock();
+    }
+}
+
+void SimulationThread::apply(const Command &command) {
+    switch (command.type) {
+    case Command::Start:
+        world.start();
+        break;
+    case Command::Reset:
+        if (coursePath != loadedCourse) {
+            loadedCourse = coursePath;
+            if (!world.loadCourse(loadedCourse)) {
+                qWarning("Failed to load obstacle course %s", qPrintable(loadedCourse));
+            }
+        }
+        if (command.fixedSeed) {
+            world.reset(command.value);
+        }
+        else {
+            world.reset();
+        }
+        recording.begin(world.getSeed());
+        recording.setCourse(world.hasCourse() ? loadedCourse : QString());
+        inputQueue.clear();
+        break;
+    case Command::HighScore:
+        world.setHighScore(static_cast<int>(command.value));
+        break;
+    }
+    applied = command.serial;
+}
+
+/**
+ * 后台槽里是两次发布之前的旧帧，逐字段赋值复用其中各 vector 的容量，稳定运行后不分配内存。
+ */
+void SimulationThread::publish() {
+    SimFrame &out = frames.back();
+    out.previous = previous;
+    out.current = current;
+    out.stepEndNs = stepEndNs;
+    out.inputCount = inputCount;
+    out.inputNs = inputNs;
+    out.serial = applied;
+    out.seed = world.getSeed();
+    out.deathCause = world.getDeathCause();
+    frames.publish();
+}
@@ -0,0 +1,164 @@
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+#include <QWaitCondition>
+#include <array>
+#include <memory>
+#include <vector>
+#include "gameworld.h"
+#include "inputlog.h"
+#include "inputqueue.h"
+#include "triplebuffer.h"
+#include "worldsnapshot.h"
+
+class QThread;
+
+/**
+ * 模拟线程发布给渲染的一帧：前后两个快照加上插值与统计所需的附加信息。
+ * 发布后不再修改，渲染只读。
+ */
+struct SimFrame {
+    /** 保留最近多少个输入时刻（界面跳过的帧不超过此数时延迟统计仍精确）。 */
+    static constexpr int recentInputs = 8;
+
+    WorldSnapshot previous;  // 上一模拟步快照
+    WorldSnapshot current;   // 最新模拟步快照
+    qint64 stepEndNs = 0;    // current 所在步的结束时刻（模拟时钟），渲染据此计算插值系数
+    quint32 inputCount = 0;  // 迄今带输入的模拟步总数（跨局递增）
+    std::array<qint64, recentInputs> inputNs{}; // 第 n 个（从 0 计）带输入步的最早输入时刻存于 [n % recentInputs]
+    quint32 serial = 0;      // 已处理的最后一条命令序号
+    quint32 seed = 0;        // 本局随机种子
+    GameWorld::DeathCause deathCause = GameWorld::DeathNone; // 本局死因
+};
+
+/**
+ * 专用模拟线程：持有 GameWorld，以固定步长（1/simulationHz）推进世界，
+ * 每批步进后把快照写入无锁三缓冲发布。界面线程只读取最新一帧，
+ * 绘制变慢、拖动窗口或模态对话框都不再拖慢物理与障碍生成。
+ *
+ * 界面线程 -> 模拟线程：开始/重开/最高分等命令与带时间戳的按键，经互斥锁入队（很少发生）。
+ * 模拟线程 -> 界面线程：只有 SimFrame，经 TripleBuffer 交换，双方都不等待。
+ * 录制（InputLog）随步进在模拟线程完成，本局结束时按需写盘。
+ */
+class SimulationThread {
+public:
+    /**
+     * 构造世界、发布初始帧并启动线程。
+     * @param profiler 分析器，世界的各阶段耗时在模拟线程记录（不转移所有权，可为空）。
+     */
+    explicit SimulationThread(FrameProfiler *profiler);
+
+    /** 停止并等待线程结束。 */
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread &) = delete;
+    SimulationThread &operator=(const SimulationThread &) = delete;
+
+    /** 预缩放贴图缓存（构造后只读，可跨线程共享）。 */
+    [[nodiscard]] const SpriteCache &getSprites() const { return world.getSprites(); }
+
+    /** 模拟时钟读数（纳秒）；输入时间戳、插值与延迟统计共用此时钟。 */
+    [[nodiscard]] qint64 elapsedNs() const { return clock.nsecsElapsed(); }
+
+    /**
+     * 开始游戏（仅在等待开始状态下生效）。
+     * @return 命令序号，SimFrame::serial 达到它时命令已生效。
+     */
+    quint32 start();
+
+    /**
+     * 重置到等待开始状态，清空未处理输入并开始新的录制。
+     * @param fixedSeed 是否使用指定种子。
+     * @param value 随机种子（fixedSeed 为 false 时忽略）。
+     * @return 命令序号。
+     */
+    quint32 reset(bool fixedSeed, quint32 value);
+
+    /**
+     * 设置历史最高分。
+     * @param value 最高分。
+     * @return 命令序号。
+     */
+    quint32 setHighScore(int value);
+
+    /**
+     * 设置录制输出路径：每局结束时把种子与输入序列写入该文件（覆盖上一局）。
+     * @param path 文件路径，为空时不录制到磁盘。
+     */
+    void setRecordPath(const QString &path);
+
+    /**
+     * 设置障碍赛道文件，下一次重置时在模拟线程载入（载入失败时打印警告并随机生成）。
+     * @param path 文件路径，为空时恢复随机生成。
+     */
+    void setCoursePath(const QString &path);
+
+    /**
+     * 按键入队，由其发生时刻所属的模拟步取出。
+     * @param eventMs QKeyEvent::timestamp()。
+     * @param kind 事件类型。
+     */
+    void push(quint64 eventMs, InputQueue::Kind kind);
+
+    /**
+     * 取最近发布的一帧到 frame()（只在界面线程调用）。
+     * @return true 表示有新帧。
+     */
+    bool acquire() { return frames.acquire(); }
+
+    /** 界面线程当前持有的帧。 */
+    [[nodiscard]] const SimFrame &frame() const { return frames.front(); }
+private:
+    struct Command {
+        enum Type : quint8 {
+            Start,
+            Reset,
+            HighScore
+        };
+        Type type;
+        bool fixedSeed;
+        quint32 value;
+        quint32 serial;
+    };
+
+    /** 入队一条命令并唤醒线程，返回其序号（需持有锁）。 */
+    quint32 post(Command::Type type, bool fixedSeed, quint32 value);
+    /** 线程主循环。 */
+    void run();
+    /** 执行一条命令（模拟线程，持有锁）。 */
+    void apply(const Command &command);
+    /** 把当前前后快照写入后台槽并发布（模拟线程）。 */
+    void publish();
+
+    QElapsedTimer clock; // 单调时钟，界面与模拟共用
+    GameWorld world;     // 只在模拟线程访问（构造除外）
+
+    // simulation-thread state
+    WorldSnapshot previous;     // 上一模拟步快照
+    WorldSnapshot current;      // 最新模拟步快照
+    qint64 stepEndNs = 0;       // current 所在步的结束时刻
+    qint64 nextStepEndNs = 0;   // 下一步的结束时刻（到达即执行）
+    quint32 applied = 0;        // 已执行的命令序号
+    quint32 inputCount = 0;     // 迄今带输入的模拟步总数
+    std::array<qint64, SimFrame::recentInputs> inputNs{}; // 最近的输入时刻（环形）
+    InputLog recording;         // 本局种子与输入事件
+    QString loadedCourse;       // 世界当前载入的赛道路径
+
+    // shared with the GUI thread, guarded by mutex
+    QMutex mutex;
+    QWaitCondition wake;        // 有新命令或需要退出
+    InputQueue inputQueue;      // 带时间戳、尚未落到模拟步上的按键事件
+    std::vector<Command> commands; // 待执行命令（按提交顺序）
+    quint32 issued = 0;         // 最后分配的命令序号
+    QString recordPath;         // 录制输出路径（为空不写盘）
+    QString coursePath;         // 赛道文件路径（为空随机生成）
+    bool stopping = false;      // 析构中
+
+    TripleBuffer<SimFrame> frames; // 模拟线程写、界面线程读
+    std::unique_ptr<QThread> thread;
+};
+
+#endif // SIMULATIONTHREAD_H
@@ -0,0 +1,80 @@
+#include "spriteatlas.h"
+#include <QPixmap>
+#include <algorithm>
+#include <numeric>
+
+/**
+ * 登记时即转换为 ARGB32_Premultiplied（已是该格式时不复制），打包时为同格式直接拷贝。
+ */
+SpriteAtlas::Id SpriteAtlas::add(const QImage &image) {
+    pending.push_back(image.isNull() ? image : image.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+    rects.emplace_back();
+    return static_cast<Id>(rects.size()) - 1;
+}
+
+/**
+ * 按高度降序逐行摆放（shelf packing），行宽取最宽贴图与 1024 的较大值。
+ */
+void SpriteAtlas::build() {
+    std::vector<int> order(pending.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return pending[a].height() > pending[b].height();
+    });
+
+    int atlasWidth = 1024;
+    for (const auto &img : pending) {
+        atlasWidth = std::max(atlasWidth, img.width() + 2 * padding);
+    }
+
+    int x = 0;
+    int y = 0;
+    int shelfHeight = 0;
+    for (int i : order) {
+        const QImage &img = pending[i];
+        if (img.isNull()) {
+            continue;
+        }
+        const int w = img.width() + 2 * padding;
+        const int h = img.height() + 2 * padding;
+        if (x + w > atlasWidth) {
+            // start a new shelf
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        rects[i] = QRect(x + padding, y + padding, img.width(), img.height());
+        x += w;
+        shelfHeight = std::max(shelfHeight, h);
+    }
+
+    atlas = QImage(atlasWidth, std::max(1, y + shelfHeight), QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+    QPainter painter(&atlas);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (!pending[i].isNull()) {
+            painter.drawImage(rects[i].topLeft(), pending[i]);
+        }
+    }
+    painter.end();
+    pending.clear();
+}
+
+void SpriteBatch::add(const QRect &source, int x, int y, qreal opacity) {
+    if (source.isEmpty()) {
+        return;
+    }
+    // fragment position is the center of the target rectangle
+    fragments.push_back(QPainter::PixmapFragment::create(
+        QPointF(x + source.width() / 2.0, y + source.height() / 2.0),
+        QRectF(source), 1.0, 1.0, 0.0, opacity));
+}
+
+void SpriteBatch::flush(QPainter &painter, const QPixmap &atlas) {
+    if (fragments.empty()) {
+        return;
+    }
+    painter.drawPixmapFragments(fragments.data(), static_cast<int>(fragments.size()), atlas);
+    fragments.clear();
+}
@@ -0,0 +1,76 @@
+#ifndef SPRITEATLAS_H
+#define SPRITEATLAS_H
+
+#include <QImage>
+#include <QPainter>
+#include <QRect>
+#include <vector>
+
+class QPixmap;
+
+/**
+ * 运行时纹理图集：把所有要绘制的贴图按行（shelf）打包进一张大图，
+ * 每个贴图对应一个子矩形，渲染时只需从同一张源图取片段。
+ */
+class SpriteAtlas {
+public:
+    using Id = int; // 贴图在图集中的编号（按 add() 顺序递增）
+
+    /**
+     * 登记一张贴图，build() 时才真正打包。空图也会占用一个编号（子矩形为空）。
+     * @param image 要打包的贴图。
+     * @return 贴图编号。
+     */
+    Id add(const QImage &image);
+
+    /**
+     * 打包全部已登记贴图并合成图集图片，之后不能再 add()。
+     */
+    void build();
+
+    /** 合成后的图集图片。 */
+    [[nodiscard]] const QImage &image() const { return atlas; }
+
+    /**
+     * 贴图在图集中的子矩形。
+     * @param id 贴图编号。
+     */
+    [[nodiscard]] const QRect &rect(Id id) const { return rects[id]; }
+
+    [[nodiscard]] int count() const { return static_cast<int>(rects.size()); }
+private:
+    static constexpr int padding = 1; // 子图间留白，避免相邻贴图串色
+
+    std::vector<QImage> pending; // 等待打包的贴图
+    std::vector<QRect> rects;    // 各贴图子矩形
+    QImage atlas;
+};
+
+/**
+ * 批量提交层：收集同一图集上的绘制片段，flush() 时用一次
+ * QPainter::drawPixmapFragments 提交，减少逐个 drawPixmap 的状态切换。
+ */
+class SpriteBatch {
+public:
+    /**
+     * 追加一个不缩放的片段。
+     * @param source 图集中的源子矩形。
+     * @param x 目标左上角 X。
+     * @param y 目标左上角 Y。
+     * @param opacity 不透明度 0-1。
+     */
+    void add(const QRect &source, int x, int y, qreal opacity = 1.0);
+
+    /**
+     * 提交并清空已收集的片段（容量保留，下一帧不再分配）。
+     * @param painter 目标画家。
+     * @param atlas 图集像素图。
+     */
+    void flush(QPainter &painter, const QPixmap &atlas);
+
+    [[nodiscard]] bool isEmpty() const { return fragments.empty(); }
+private:
+    std::vector<QPainter::PixmapFragment> fragments;
+};
+
+#endif // SPRITEATLAS_H
@@ -0,0 +1,104 @@
+#include "spritecache.h"
+#include "assetloader.h"
+#include "gameconfig.h"
+#include <QThreadPool>
+#include <algorithm>
+#include <vector>
+
+/**
+ * 构建缓存：恐龙帧按绘制尺寸各一份，仙人掌与鸟每档位各一份。
+ * 先登记全部源贴图，再逐张取预解码数据；取不到的交给线程池并行解码，全部完成后返回。
+ * 结果统一为光栅引擎的快速格式 ARGB32_Premultiplied，之后的打包与绘制不再做格式转换。
+ */
+SpriteCache::SpriteCache() {
+    std::vector<Job> jobs;
+    int next = 0;
+    dinoBase = next;
+    for (int f = 0; f < Dino::FrameCount; ++f) {
+        jobs.push_back({Dino::framePaths[f], next++, 1, Dino::frameSize(static_cast<Dino::Frame>(f)), {}, {0, 0}});
+    }
+
+    cactusBase = next;
+    for (int kind = 0; kind < cactusKinds; ++kind) {
+        Job job{cactusSpritePaths[kind], next, scaleBuckets, QSize(), {}, cactusSourceSizes[kind]};
+        for (int k = 0; k < scaleBuckets; ++k) {
+            job.scales[static_cast<size_t>(k)] = cactusScale(kind, k);
+        }
+        jobs.push_back(job);
+        next += scaleBuckets;
+    }
+
+    birdBase = next;
+    for (int frame = 0; frame < birdFrames; ++frame) {
+        Job job{birdSpritePaths[frame], next, scaleBuckets, QSize(), {}, birdSourceSizes[frame]};
+        for (int k = 0; k < scaleBuckets; ++k) {
+            job.scales[static_cast<size_t>(k)] = birdScale(k);
+        }
+        jobs.push_back(job);
+        next += scaleBuckets;
+    }
+
+    // sized up front: decode tasks write disjoint entries concurrently
+    entries.resize(static_cast<size_t>(next));
+    QThreadPool pool;
+    for (const Job &job : jobs) {
+        if (!loadBaked(job)) {
+            pool.start([this, job] { decode(job); });
+        }
+    }
+    pool.waitForDone();
+}
+
+SpriteCache::Handle SpriteCache::animated(Handle handle, int frameCount) const {
+    if (!isBird(handle)) {
+        return handle;
+    }
+    const int bucket = (handle - birdBase) % scaleBuckets;
+    return bird((frameCount / GameConfig::birdAnimationFrames) % birdFrames, bucket);
+}
+
+bool SpriteCache::loadBaked(const Job &job) {
+    std::vector<QImage> images;
+    for (int k = 0; k < job.count; ++k) {
+        QImage img = AssetLoader::bakedSprite(job.first + k, job.path);
+        if (img.isNull()) {
+            return false;
+        }
+        images.push_back(std::move(img));
+    }
+    for (int k = 0; k < job.count; ++k) {
+        Entry &e = entries[static_cast<size_t>(job.first + k)];
+        e.image = std::move(images[static_cast<size_t>(k)]);
+        e.mask = CollisionMask(e.image);
+        e.source = job.path;
+    }
+    return true;
+}
+
+/**
+ * 解码一次源贴图，按固定尺寸或各档位缩放系数生成全部条目。
+ */
+void SpriteCache::decode(const Job &job) {
+    const QImage source = AssetLoader::load(job.path);
+    if (!source.isNull() && job.source.width > 0
+        && (source.width() != job.source.width || source.height() != job.source.height)) {
+        qWarning("%s is %dx%d but the jump tables assume %dx%d; obstacles may be skipped or spaced out",
+                 job.path, source.width(), source.height(), job.source.width, job.source.height);
+    }
+    for (int k = 0; k < job.count; ++k) {
+        Entry &e = entries[static_cast<size_t>(job.first + k)];
+        e.source = job.path;
+        if (source.isNull()) {
+            continue;
+        }
+        if (job.size.isValid()) {
+            e.image = source.scaled(job.size).convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        }
+        else {
+            const double scale = job.scales[static_cast<size_t>(k)];
+            e.image = source.scaled(static_cast<int>(source.width() * scale), static_cast<int>(source.height() * scale), Qt::KeepAspectRatio, Qt::SmoothTransformation)
+                          .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        }
+        e.mask = CollisionMask(e.image);
+    }
+}
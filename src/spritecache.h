@@ -0,0 +1,179 @@
+#ifndef SPRITECACHE_H
+#define SPRITECACHE_H
+
+#include <QImage>
+#include <QSize>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include "collisionmask.h"
+#include "dino.h"
+#include "gameconfig.h"
+
+/**
+ * 预缩放贴图缓存：启动时把恐龙各帧、仙人掌与鸟的每个缩放档位缩放好并建掩码，
+ * 障碍只保存 Handle，生成时按档位直接取用，帧循环内不再缩放或分配贴图。
+ * 只使用 QImage，可在无头仿真中构建；渲染层按 Handle 建立对应的 QPixmap。
+ */
+class SpriteCache {
+public:
+    using Handle = int; // 缓存条目索引
+
+    /** 仙人掌贴图数量：前 smallCactusKinds 个为小型，其余为大型。 */
+    static constexpr int smallCactusKinds = 3;
+    static constexpr int largeCactusKinds = 3;
+    static constexpr int cactusKinds = smallCactusKinds + largeCactusKinds;
+    static constexpr int birdFrames = 2;   // 鸟动画帧数
+    static constexpr int scaleBuckets = 8; // 每种贴图的缩放档位数
+
+    /** 仙人掌贴图资源路径，前 smallCactusKinds 个为小型。 */
+    static constexpr const char *cactusSpritePaths[cactusKinds] = {
+        ":/cactus/SmallCactus1.png",
+        ":/cactus/SmallCactus2.png",
+        ":/cactus/SmallCactus3.png",
+        ":/cactus/LargeCactus1.png",
+        ":/cactus/LargeCactus2.png",
+        ":/cactus/LargeCactus3.png"
+    };
+
+    /** 鸟动画帧资源路径。 */
+    static constexpr const char *birdSpritePaths[birdFrames] = {
+        ":/bird/Bird1.png",
+        ":/bird/Bird2.png"
+    };
+
+    /** 编译期可用的贴图尺寸。 */
+    struct Size {
+        int width;
+        int height;
+    };
+
+    /**
+     * 源贴图尺寸，与 resources 中的 PNG 一致。JumpTable 据此在编译期检查障碍的公平性；
+     * 解码出的源贴图尺寸不符时（替换了贴图或模组）打印警告，编译期检查不再成立。
+     */
+    static constexpr Size cactusSourceSizes[cactusKinds] = {
+        {40, 71}, {68, 71}, {105, 71},
+        {48, 95}, {99, 95}, {102, 95}
+    };
+    static constexpr Size birdSourceSizes[birdFrames] = {{97, 68}, {93, 62}};
+
+    struct Entry {
+        QImage image;       // 已缩放到绘制尺寸的贴图（ARGB32_Premultiplied）
+        CollisionMask mask; // 同尺寸的碰撞掩码
+        const char *source = nullptr; // 来源资源路径
+    };
+
+    /**
+     * 构建全部缓存条目（仅在启动时执行一次）。优先零拷贝包装构建时预解码、预缩放的数据
+     * （BakedAssets），只需建掩码；被覆盖（见 AssetLoader）或缺少预解码数据的源贴图
+     * 在线程池中并行解码与缩放，每张源贴图一个任务。
+     */
+    SpriteCache();
+
+    /** 恐龙某帧（绘制尺寸）的条目。 */
+    [[nodiscard]] Handle dino(Dino::Frame frame) const { return dinoBase + frame; }
+
+    /**
+     * 仙人掌某种类某档位的条目。
+     * @param kind 种类索引（见 cactusSpritePaths）。
+     * @param bucket 缩放档位 [0, scaleBuckets)。
+     */
+    [[nodiscard]] Handle cactus(int kind, int bucket) const { return cactusBase + kind * scaleBuckets + bucket; }
+
+    /**
+     * 鸟某动画帧某档位的条目。
+     * @param frame 动画帧 [0, birdFrames)。
+     * @param bucket 缩放档位 [0, scaleBuckets)。
+     */
+    [[nodiscard]] Handle bird(int frame, int bucket) const { return birdBase + frame * scaleBuckets + bucket; }
+
+    /** 是否为鸟的条目（任一动画帧、任一档位）。 */
+    [[nodiscard]] bool isBird(Handle handle) const {
+        return handle >= birdBase && handle < birdBase + birdFrames * scaleBuckets;
+    }
+
+    /**
+     * 动画帧解析：鸟的条目换成全局帧时钟对应的动画帧（档位不变），其他条目原样返回。
+     * 所有鸟共享同一组预缩放帧，障碍本身不保存动画状态。
+     * @param handle 障碍保存的句柄。
+     * @param frameCount 本局已模拟帧数。
+     */
+    [[nodiscard]] Handle animated(Handle handle, int frameCount) const;
+
+    [[nodiscard]] const Entry &entry(Handle handle) const { return entries[handle]; }
+    [[nodiscard]] int size() const { return static_cast<int>(entries.size()); }
+
+    /**
+     * 档位对应的缩放系数：把 [min,max] 等分为 scaleBuckets 段，取段中点。
+     * @param min 缩放下限。
+     * @param max 缩放上限。
+     * @param bucket 档位。
+     */
+    static constexpr double bucketScale(double min, double max, int bucket) {
+        return min >= max ? min : min + (max - min) * (bucket + 0.5) / scaleBuckets;
+    }
+
+    /** 仙人掌某种类某档位的缩放系数（LargeCactus3 另有上限，压缩其宽度）。 */
+    static constexpr double cactusScale(int kind, int bucket) {
+        const bool large = kind >= smallCactusKinds;
+        const double scale = bucketScale(large ? GameConfig::cactusScaleLargeMin : GameConfig::cactusScaleSmallMin,
+                                         large ? GameConfig::cactusScaleLargeMax : GameConfig::cactusScaleSmallMax, bucket);
+        return kind == cactusKinds - 1 ? std::min(scale, GameConfig::cactusScaleLarge3Cap) : scale;
+    }
+
+    /** 鸟某档位的缩放系数。 */
+    static constexpr double birdScale(int bucket) {
+        return bucketScale(GameConfig::birdScaleMin, GameConfig::birdScaleMax, bucket);
+    }
+
+    /**
+     * 缩放后的绘制尺寸，与 decode() 中 QImage::scaled(w·scale, h·scale, Qt::KeepAspectRatio)
+     * 的取整规则一致（同 QSize::scaled）。
+     */
+    static constexpr Size scaledSize(const Size &source, double scale) {
+        const int width = static_cast<int>(source.width * scale);
+        const int height = static_cast<int>(source.height * scale);
+        const qint64 byHeight = qint64(height) * source.width / source.height;
+        if (byHeight <= width) {
+            return {static_cast<int>(byHeight), height};
+        }
+        return {width, static_cast<int>(qint64(width) * source.height / source.width)};
+    }
+
+    /** 仙人掌某种类某档位的绘制尺寸。 */
+    static constexpr Size cactusSize(int kind, int bucket) {
+        return scaledSize(cactusSourceSizes[kind], cactusScale(kind, bucket));
+    }
+
+    /** 鸟某动画帧某档位的绘制尺寸。 */
+    static constexpr Size birdSize(int frame, int bucket) {
+        return scaledSize(birdSourceSizes[frame], birdScale(bucket));
+    }
+private:
+    /** 一张源贴图及由它产生的连续条目。 */
+    struct Job {
+        const char *path; // 资源路径
+        int first;        // 第一个条目句柄
+        int count;        // 条目数（1 或 scaleBuckets）
+        QSize size;       // 固定绘制尺寸（有效时忽略缩放参数）
+        std::array<double, scaleBuckets> scales; // 各档位缩放系数
+        Size source;      // 编译期假定的源尺寸（宽为 0 时不检查）
+    };
+
+    /**
+     * 用预解码数据填充 job 的全部条目。
+     * @return 任一条目缺少预解码数据时返回 false（不修改任何条目）。
+     */
+    bool loadBaked(const Job &job);
+
+    /** 解码源贴图并按 job 缩放出全部条目（线程池任务，只写自己的条目）。 */
+    void decode(const Job &job);
+
+    std::vector<Entry> entries;
+    Handle dinoBase = 0;
+    Handle cactusBase = 0;
+    Handle birdBase = 0;
+};
+
+#endif // SPRITECACHE_H
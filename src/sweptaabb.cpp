@@ -0,0 +1,52 @@
+#include "sweptaabb.h"
+
+namespace {
+
+/**
+ * 把约束 c0 + c1 * t >= 0 与当前区间 [lo, hi] 求交。
+ * @return 区间仍非空时返回 true。
+ */
+bool clip(double c0, double c1, double &lo, double &hi) {
+    if (c1 == 0.0) {
+        return c0 >= 0.0;
+    }
+    const double root = -c0 / c1;
+    if (c1 > 0.0) {
+        lo = root > lo ? root : lo;
+    }
+    else {
+        hi = root < hi ? root : hi;
+    }
+    return lo <= hi;
+}
+
+/**
+ * 约束 “p 边 >= q 边”：两条边都线性移动，差值仍是 t 的一次函数。
+ */
+bool clipEdges(int pFrom, int pTo, int qFrom, int qTo, double &lo, double &hi) {
+    const double c0 = pFrom - qFrom;
+    const double c1 = (pTo - pFrom) - (qTo - qFrom);
+    return clip(c0, c1, lo, hi);
+}
+
+} // namespace
+
+/**
+ * 相交等价于四个不等式同时成立（与 QRect::intersects 相同）：
+ * b.right >= a.left，a.right >= b.left，b.bottom >= a.top，a.bottom >= b.top。
+ * 每条边都随 t 线性变化，所以每个不等式截出一个半区间，依次求交即可。
+ */
+bool SweptAabb::overlapInterval(const QRect &aFrom, const QRect &aTo, const QRect &bFrom, const QRect &bTo,
+                                double &enter, double &exit) {
+    double lo = 0.0;
+    double hi = 1.0;
+    if (!clipEdges(bFrom.right(), bTo.right(), aFrom.left(), aTo.left(), lo, hi)
+        || !clipEdges(aFrom.right(), aTo.right(), bFrom.left(), bTo.left(), lo, hi)
+        || !clipEdges(bFrom.bottom(), bTo.bottom(), aFrom.top(), aTo.top(), lo, hi)
+        || !clipEdges(aFrom.bottom(), aTo.bottom(), bFrom.top(), bTo.top(), lo, hi)) {
+        return false;
+    }
+    enter = lo;
+    exit = hi;
+    return true;
+}
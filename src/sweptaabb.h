@@ -0,0 +1,29 @@
+#ifndef SWEPTAABB_H
+#define SWEPTAABB_H
+
+#include <QRect>
+
+/**
+ * 扫掠包围盒（连续碰撞粗判）：一步之内矩形的四条边各自从起始位置线性移动到结束位置，
+ * 求两个这样的矩形在 t∈[0,1] 上相交的时间区间。只看两端的离散判定会漏掉
+ * 一步内整段穿过的窄障碍（高速下的“隧穿”），扫掠判定不会。
+ * 矩形沿用 QRect 的闭区间语义（right/bottom 含在内），与 QRect::intersects 一致。
+ */
+namespace SweptAabb {
+
+/**
+ * 求两个线性移动矩形的相交时间区间。
+ * @param aFrom a 在步初（t=0）的位置。
+ * @param aTo a 在步末（t=1）的位置。
+ * @param bFrom b 在步初的位置。
+ * @param bTo b 在步末的位置。
+ * @param enter 输出：开始相交的时刻。
+ * @param exit 输出：结束相交的时刻（enter <= exit）。
+ * @return 步内任一时刻相交时返回 true。
+ */
+bool overlapInterval(const QRect &aFrom, const QRect &aTo, const QRect &bFrom, const QRect &bTo,
+                     double &enter, double &exit);
+
+} // namespace SweptAabb
+
+#endif // SWEPTAABB_H
@@ -0,0 +1,143 @@
+#include "gamerenderer.h"
+#include "gameworld.h"
+#include "gameconfig.h"
+#include "population.h"
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+#include <QTextStream>
+#include <QThreadPool>
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+/**
+ * 在最后一代的赛道上单线程重跑种群，每隔 every 帧把存活个体以半透明叠加渲染成一张 PNG。
+ * 种群与赛道都与评估时相同，因此画面就是该代实际的存活过程。
+ * @return 写出的图片数，失败返回 -1。
+ */
+int renderShowcase(Population &population, const std::shared_ptr<const SpriteCache> &sprites,
+                   quint32 courseSeed, int maxFrames, const QString &dir, int every) {
+    if (!QDir().mkpath(dir)) {
+        return -1;
+    }
+    GameWorld world(sprites);
+    world.setDinoCollision(false);
+    world.reset(courseSeed);
+    world.start();
+    population.begin(0, population.size());
+
+    GameRenderer renderer(*sprites);
+    QImage image(GameConfig::windowWidth, GameConfig::windowHeight, QImage::Format_ARGB32_Premultiplied);
+    WorldSnapshot snapshot;
+    int written = 0;
+    int survivors = population.size();
+    while (survivors > 0 && world.getFrameCount() < maxFrames) {
+        survivors = population.step(world, 0, population.size());
+        if (world.getFrameCount() % every != 0 && survivors > 0) {
+            continue; // always keep the frame where the last agent dies
+        }
+        world.snapshot(snapshot);
+        population.ghosts(world, snapshot);
+        {
+            QPainter painter(&image);
+            renderer.render(painter, snapshot);
+        }
+        const QString path = QDir(dir).filePath(QStringLiteral("train_%1.png").arg(world.getFrameCount(), 6, 10, QChar('0')));
+        if (!image.save(path)) {
+            return -1;
+        }
+        ++written;
+    }
+    return written;
+}
+
+} // namespace
+
+/**
+ * 神经进化训练入口：种群在同一条障碍流上并行评估，按存活帧数选择与变异，
+ * 每代输出最佳/平均存活帧数与耗时，结束时报告 generations/s（主要指标）。
+ * 第 g 代使用赛道种子 seed + g，避免只记住一条赛道。
+ * 指定 --render 时把最后一代的存活过程渲染为半透明叠加图片序列。
+ */
+int main(int argc, char *argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen"); // no display needed
+    }
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName("dino_train");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("DinoGame neuroevolution trainer");
+    parser.addHelpOption();
+    QCommandLineOption populationOption("population", "Number of agents per generation.", "n",
+                                        QString::number(GameConfig::trainPopulation));
+    parser.addOption(populationOption);
+    QCommandLineOption generationsOption("generations", "Number of generations to train.", "n", "50");
+    parser.addOption(generationsOption);
+    QCommandLineOption seedOption("seed", "Seed for the weights; generation g runs on course seed + g.", "n", "1");
+    parser.addOption(seedOption);
+    QCommandLineOption maxFramesOption("max-frames", "Frame cap per generation.", "n",
+                                       QString::number(GameConfig::trainMaxFrames));
+    parser.addOption(maxFramesOption);
+    QCommandLineOption threadsOption("threads", "Worker threads (default: all cores).", "n");
+    parser.addOption(threadsOption);
+    QCommandLineOption renderOption("render", "Render the last generation's run as translucent overlays into this directory.", "dir");
+    parser.addOption(renderOption);
+    QCommandLineOption renderEveryOption("render-every", "Frames between rendered images.", "n", "10");
+    parser.addOption(renderEveryOption);
+    parser.process(app);
+
+    const int size = std::max(parser.value(populationOption).toInt(), 1);
+    const int generations = std::max(parser.value(generationsOption).toInt(), 1);
+    const quint32 seed = parser.value(seedOption).toUInt();
+    const int maxFrames = std::max(parser.value(maxFramesOption).toInt(), 1);
+    QThreadPool pool;
+    if (parser.isSet(threadsOption)) {
+        pool.setMaxThreadCount(std::max(parser.value(threadsOption).toInt(), 1));
+    }
+
+    auto sprites = std::make_shared<const SpriteCache>();
+    Population population(size, seed, sprites);
+    QTextStream out(stdout);
+    out << "population: " << size << " threads: " << pool.maxThreadCount() << '\n';
+    out << "generation,best_frames,mean_frames,agent_steps,elapsed_ms\n";
+
+    qint64 agentSteps = 0;
+    int best = 0;
+    QElapsedTimer clock;
+    clock.start();
+    for (int g = 0; g < generations; ++g) {
+        const Population::Generation result = population.evaluate(seed + static_cast<quint32>(g), maxFrames, pool);
+        agentSteps += result.agentSteps;
+        best = std::max(best, result.best);
+        out << result.index << ',' << result.best << ',' << QString::number(result.mean, 'f', 1) << ','
+            << result.agentSteps << ',' << QString::number(result.elapsedNs / 1e6, 'f', 2) << '\n';
+        out.flush();
+        if (g + 1 < generations) {
+            population.evolve();
+        }
+    }
+    const qint64 elapsedNs = qMax<qint64>(clock.nsecsElapsed(), 1);
+
+    out << "best frames: " << best << '\n';
+    out << "elapsed ms: " << elapsedNs / 1000000.0 << '\n';
+    out << "agent steps/s: " << double(agentSteps) * 1e9 / double(elapsedNs) << '\n';
+    out << "generations/s: " << double(generations) * 1e9 / double(elapsedNs) << '\n';
+
+    if (parser.isSet(renderOption)) {
+        const int every = std::max(parser.value(renderEveryOption).toInt(), 1);
+        const int written = renderShowcase(population, sprites, seed + static_cast<quint32>(generations - 1),
+                                           maxFrames, parser.value(renderOption), every);
+        if (written < 0) {
+            out << "failed to write images to " << parser.value(renderOption) << '\n';
+            return 1;
+        }
+        out << "rendered images: " << written << '\n';
+    }
+    return 0;
+}
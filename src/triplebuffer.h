@@ -0,0 +1,50 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * 单写者、单读者的无锁三缓冲：写者总在自己的后台槽里写完整个值再发布，
+ * 读者随时取走最近发布的那一份，双方都不会等待对方，也不会看到写了一半的值。
+ * 三个缓冲分别归写者、读者与“中间”所有；发布与读取都只是一次原子交换中间槽下标。
+ * 读者来不及读的旧值直接被新值覆盖（只关心最新状态）。
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /** 写者的后台槽（只在写者线程访问）。 */
+    T &back() { return buffers[static_cast<std::size_t>(backIndex)]; }
+
+    /** 发布后台槽，换回上一次的中间槽继续写（写者线程）。 */
+    void publish() {
+        backIndex = middle.exchange(backIndex | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    /**
+     * 有新发布的值时把它换到读者槽（读者线程）。
+     * @return true 表示 front() 已更新。
+     */
+    bool acquire() {
+        if ((middle.load(std::memory_order_relaxed) & freshBit) == 0) {
+            return false;
+        }
+        const int old = middle.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = old & indexMask;
+        return true;
+    }
+
+    /** 读者当前持有的值（只在读者线程访问）。 */
+    const T &front() const { return buffers[static_cast<std::size_t>(frontIndex)]; }
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshBit = 4; // 中间槽是读者尚未取走的新值
+
+    std::array<T, 3> buffers;
+    alignas(64) std::atomic<int> middle{1}; // 中间槽下标 | freshBit
+    alignas(64) int backIndex = 0;          // 写者独占
+    alignas(64) int frontIndex = 2;         // 读者独占
+};
+
+#endif // TRIPLEBUFFER_H
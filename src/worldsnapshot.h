@@ -0,0 +1,34 @@
+#ifndef WORLDSNAPSHOT_H
+#define WORLDSNAPSHOT_H
+
+#include <QRect>
+#include <vector>
+#include "spritecache.h"
+
+/**
+ * 渲染所需的世界状态快照（只读数据，不含任何逻辑）。
+ * 渲染层在前后两个快照之间插值，模拟频率与显示刷新率因此互不影响。
+ */
+struct WorldSnapshot {
+    struct Sprite {
+        SpriteCache::Handle sprite; // 贴图句柄
+        int x;                      // 左上角 X
+        int y;                      // 左上角 Y
+    };
+
+    bool running = false;      // 游戏是否在运行
+    bool gameOver = false;     // 游戏是否结束
+    int frameCount = 0;        // 本局已模拟帧数
+    int groundOffset = 0;      // 地面滚动偏移
+    int score = 0;             // 当前分数
+    int highScore = 0;         // 最高分
+    bool showDino = true;      // 是否绘制世界自身的恐龙（训练模式下世界只是障碍流）
+    SpriteCache::Handle dinoSprite = 0; // 恐龙当前帧贴图句柄
+    QRect dinoRect;            // 恐龙绘制矩形
+    bool dinoAirborne = false; // 恐龙是否在空中
+    int landFrame = -1;        // 本局最近一次落地的帧号（-1 表示尚未落地过）
+    std::vector<Sprite> obstacles; // 障碍（按生成顺序，即 x 递增）
+    std::vector<Sprite> ghosts;    // 训练种群的存活个体（半透明叠加，同一姿态只保留一份）
+};
+
+#endif // WORLDSNAPSHOT_H